@@ -8,8 +8,12 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/task_runner_util.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/extensions/api/brave_action_api.h"
 #include "brave/browser/webcompat_reporter/webcompat_reporter_dialog.h"
@@ -47,26 +51,22 @@ namespace {
 const char kInvalidUrlError[] = "Invalid URL.";
 const char kInvalidControlTypeError[] = "Invalid ControlType.";
 
-}  // namespace
-
-
-ExtensionFunction::ResponseAction
-BraveShieldsHostnameCosmeticResourcesFunction::Run() {
-  std::unique_ptr<brave_shields::HostnameCosmeticResources::Params> params(
-      brave_shields::HostnameCosmeticResources::Params::Create(*args_));
-  EXTENSION_FUNCTION_VALIDATE(params.get());
-
-  base::Optional<base::Value> resources = g_brave_browser_process->
-      ad_block_service()->HostnameCosmeticResources(params->hostname);
+// The ad block engines are used and replaced on the ad block services' task
+// runner, so cosmetic filtering lookups run there instead of on the UI thread.
+base::Optional<base::Value> GetHostnameCosmeticResourcesOnTaskRunner(
+    brave_shields::AdBlockService* ad_block_service,
+    brave_shields::AdBlockRegionalServiceManager* regional_service_manager,
+    brave_shields::AdBlockCustomFiltersService* custom_filters_service,
+    const std::string& hostname) {
+  base::Optional<base::Value> resources =
+      ad_block_service->HostnameCosmeticResources(hostname);
 
   if (!resources || !resources->is_dict()) {
-    return RespondNow(Error(
-        "Hostname-specific cosmetic resources could not be returned"));
+    return base::nullopt;
   }
 
-  base::Optional<base::Value> regional_resources = g_brave_browser_process->
-      ad_block_regional_service_manager()->
-          HostnameCosmeticResources(params->hostname);
+  base::Optional<base::Value> regional_resources =
+      regional_service_manager->HostnameCosmeticResources(hostname);
 
   if (regional_resources && regional_resources->is_dict()) {
     ::brave_shields::MergeResourcesInto(
@@ -75,9 +75,8 @@ BraveShieldsHostnameCosmeticResourcesFunction::Run() {
             false);
   }
 
-  base::Optional<base::Value> custom_resources = g_brave_browser_process->
-      ad_block_custom_filters_service()->
-          HostnameCosmeticResources(params->hostname);
+  base::Optional<base::Value> custom_resources =
+      custom_filters_service->HostnameCosmeticResources(hostname);
 
   if (custom_resources && custom_resources->is_dict()) {
     ::brave_shields::MergeResourcesInto(
@@ -86,29 +85,23 @@ BraveShieldsHostnameCosmeticResourcesFunction::Run() {
             true);
   }
 
-  auto result_list = std::make_unique<base::ListValue>();
-
-  result_list->Append(std::move(*resources));
-
-  return RespondNow(ArgumentList(std::move(result_list)));
+  return resources;
 }
 
-ExtensionFunction::ResponseAction
-BraveShieldsHiddenClassIdSelectorsFunction::Run() {
-  std::unique_ptr<brave_shields::HiddenClassIdSelectors::Params> params(
-      brave_shields::HiddenClassIdSelectors::Params::Create(*args_));
-  EXTENSION_FUNCTION_VALIDATE(params.get());
-
-  base::Optional<base::Value> hide_selectors = g_brave_browser_process->
-      ad_block_service()->HiddenClassIdSelectors(params->classes,
-                                                 params->ids,
-                                                 params->exceptions);
-
-  base::Optional<base::Value> regional_selectors = g_brave_browser_process->
-      ad_block_regional_service_manager()->
-        HiddenClassIdSelectors(params->classes,
-                               params->ids,
-                               params->exceptions);
+std::unique_ptr<base::ListValue> GetHiddenClassIdSelectorsOnTaskRunner(
+    brave_shields::AdBlockService* ad_block_service,
+    brave_shields::AdBlockRegionalServiceManager* regional_service_manager,
+    brave_shields::AdBlockCustomFiltersService* custom_filters_service,
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  base::Optional<base::Value> hide_selectors =
+      ad_block_service->HiddenClassIdSelectors(classes, ids, exceptions);
+
+  base::Optional<base::Value> regional_selectors =
+      regional_service_manager->HiddenClassIdSelectors(classes,
+                                                       ids,
+                                                       exceptions);
 
   if (hide_selectors && hide_selectors->is_list()) {
     if (regional_selectors && regional_selectors->is_list()) {
@@ -122,20 +115,106 @@ BraveShieldsHiddenClassIdSelectorsFunction::Run() {
     hide_selectors = std::move(regional_selectors);
   }
 
-  base::Optional<base::Value> custom_selectors = g_brave_browser_process->
-      ad_block_custom_filters_service()->
-          HiddenClassIdSelectors(params->classes,
-                                 params->ids,
-                                 params->exceptions);
+  base::Optional<base::Value> custom_selectors =
+      custom_filters_service->HiddenClassIdSelectors(classes,
+                                                     ids,
+                                                     exceptions);
+
+  auto result_list = std::make_unique<base::ListValue>();
+
+  result_list->Append(hide_selectors ? std::move(*hide_selectors)
+                                     : base::Value(base::Value::Type::LIST));
+  result_list->Append(custom_selectors ? std::move(*custom_selectors)
+                                       : base::Value(base::Value::Type::LIST));
+
+  return result_list;
+}
+
+}  // namespace
+
+
+ExtensionFunction::ResponseAction
+BraveShieldsHostnameCosmeticResourcesFunction::Run() {
+  std::unique_ptr<brave_shields::HostnameCosmeticResources::Params> params(
+      brave_shields::HostnameCosmeticResources::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  auto* ad_block_service = g_brave_browser_process->ad_block_service();
+  base::PostTaskAndReplyWithResult(
+      ad_block_service->GetTaskRunner().get(),
+      FROM_HERE,
+      base::BindOnce(&GetHostnameCosmeticResourcesOnTaskRunner,
+          base::Unretained(ad_block_service),
+          base::Unretained(g_brave_browser_process->
+              ad_block_regional_service_manager()),
+          base::Unretained(g_brave_browser_process->
+              ad_block_custom_filters_service()),
+          params->hostname),
+      base::BindOnce(
+          &BraveShieldsHostnameCosmeticResourcesFunction::
+              OnGetHostnameCosmeticResources,
+          this,
+          base::TimeTicks::Now()));
+
+  return RespondLater();
+}
+
+void BraveShieldsHostnameCosmeticResourcesFunction::
+    OnGetHostnameCosmeticResources(
+        base::TimeTicks start_time,
+        base::Optional<base::Value> resources) {
+  UMA_HISTOGRAM_TIMES("Brave.Shields.HostnameCosmeticResources",
+                      base::TimeTicks::Now() - start_time);
+
+  if (!resources) {
+    Respond(Error(
+        "Hostname-specific cosmetic resources could not be returned"));
+    return;
+  }
 
   auto result_list = std::make_unique<base::ListValue>();
 
-  result_list->Append(std::move(*hide_selectors));
-  result_list->Append(std::move(*custom_selectors));
+  result_list->Append(std::move(*resources));
 
-  return RespondNow(ArgumentList(std::move(result_list)));
+  Respond(ArgumentList(std::move(result_list)));
 }
 
+ExtensionFunction::ResponseAction
+BraveShieldsHiddenClassIdSelectorsFunction::Run() {
+  std::unique_ptr<brave_shields::HiddenClassIdSelectors::Params> params(
+      brave_shields::HiddenClassIdSelectors::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  auto* ad_block_service = g_brave_browser_process->ad_block_service();
+  base::PostTaskAndReplyWithResult(
+      ad_block_service->GetTaskRunner().get(),
+      FROM_HERE,
+      base::BindOnce(&GetHiddenClassIdSelectorsOnTaskRunner,
+          base::Unretained(ad_block_service),
+          base::Unretained(g_brave_browser_process->
+              ad_block_regional_service_manager()),
+          base::Unretained(g_brave_browser_process->
+              ad_block_custom_filters_service()),
+          params->classes,
+          params->ids,
+          params->exceptions),
+      base::BindOnce(
+          &BraveShieldsHiddenClassIdSelectorsFunction::
+              OnGetHiddenClassIdSelectors,
+          this,
+          base::TimeTicks::Now()));
+
+  return RespondLater();
+}
+
+void BraveShieldsHiddenClassIdSelectorsFunction::OnGetHiddenClassIdSelectors(
+    base::TimeTicks start_time,
+    std::unique_ptr<base::ListValue> result_list) {
+  UMA_HISTOGRAM_TIMES("Brave.Shields.HiddenClassIdSelectors",
+                      base::TimeTicks::Now() - start_time);
+
+  Respond(ArgumentList(std::move(result_list)));
+}
 
 ExtensionFunction::ResponseAction BraveShieldsAllowScriptsOnceFunction::Run() {
   std::unique_ptr<brave_shields::AllowScriptsOnce::Params> params(
@@ -6,6 +6,11 @@
 #ifndef BRAVE_BROWSER_EXTENSIONS_API_BRAVE_SHIELDS_API_H_
 #define BRAVE_BROWSER_EXTENSIONS_API_BRAVE_SHIELDS_API_H_
 
+#include <memory>
+
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "base/values.h"
 #include "extensions/browser/extension_function.h"
 
 namespace extensions {
@@ -19,6 +24,10 @@ class BraveShieldsHostnameCosmeticResourcesFunction : public ExtensionFunction {
   ~BraveShieldsHostnameCosmeticResourcesFunction() override {}
 
   ResponseAction Run() override;
+
+ private:
+  void OnGetHostnameCosmeticResources(base::TimeTicks start_time,
+                                      base::Optional<base::Value> resources);
 };
 
 class BraveShieldsHiddenClassIdSelectorsFunction : public ExtensionFunction {
@@ -29,6 +38,11 @@ class BraveShieldsHiddenClassIdSelectorsFunction : public ExtensionFunction {
   ~BraveShieldsHiddenClassIdSelectorsFunction() override {}
 
   ResponseAction Run() override;
+
+ private:
+  void OnGetHiddenClassIdSelectors(
+      base::TimeTicks start_time,
+      std::unique_ptr<base::ListValue> result_list);
 };
 
 class BraveShieldsAllowScriptsOnceFunction : public ExtensionFunction {
@@ -3,6 +3,12 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <string>
+#include <vector>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/task/post_task.h"
@@ -18,10 +24,13 @@
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/common/constants.h"
 #include "net/dns/mock_host_resolver.h"
 
 using brave_rewards::RewardsService;
 using brave_rewards::RewardsServiceFactory;
+using extensions::Extension;
 using extensions::ExtensionBrowserTest;
 using greaselion::GreaselionDownloadService;
 using greaselion::GreaselionService;
@@ -29,6 +38,10 @@ using greaselion::GreaselionServiceFactory;
 
 const char kTestDataDirectory[] = "greaselion-data";
 const char kEmbeddedTestServerDirectory[] = "greaselion";
+// The rule for www.a.com in the test data
+const char kTestRuleName[] = "greaselion-1";
+// The rule for pre1.example.com, which needs rewards to be enabled
+const char kRewardsRuleName[] = "greaselion-2";
 
 class GreaselionDownloadServiceWaiter
     : public GreaselionDownloadService::Observer {
@@ -130,6 +143,62 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
     // after the rewards service is turned off or on
     GreaselionServiceWaiter(greaselion_service).Wait();
   }
+
+  // Loads the rules in |install_dir| as if the Greaselion component had been
+  // updated to them
+  void LoadRules(const base::FilePath& install_dir) {
+    service()->OnComponentReady(std::string(), install_dir, std::string());
+    WaitForService();
+  }
+
+  base::FilePath GetTestRulesDir() {
+    base::FilePath test_data_dir;
+    GetTestDataDir(&test_data_dir);
+    return test_data_dir.AppendASCII(test_data_directory());
+  }
+
+  // Returns a copy of the test rules which the test can change
+  base::FilePath CopyTestRules() {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    EXPECT_TRUE(temp_dir_.CreateUniqueTempDir());
+    EXPECT_TRUE(
+        base::CopyDirectory(GetTestRulesDir(), temp_dir_.GetPath(), true));
+    return temp_dir_.GetPath().AppendASCII(test_data_directory());
+  }
+
+  base::FilePath GetCacheDir() {
+    return profile()->GetPath().AppendASCII("Greaselion");
+  }
+
+  // Returns the installed extension converted from the rule named
+  // |rule_name|, or nullptr
+  const Extension* GetGreaselionExtension(const std::string& rule_name) {
+    for (const auto& extension :
+         extensions::ExtensionRegistry::Get(profile())->enabled_extensions()) {
+      if (extension->location() == extensions::Manifest::COMPONENT &&
+          extension->name() == rule_name)
+        return extension.get();
+    }
+    return nullptr;
+  }
+
+  std::string GetTitleOfPage(const std::string& host) {
+    GURL url = embedded_test_server()->GetURL(host, "/simple.html");
+    ui_test_utils::NavigateToURL(browser(), url);
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    EXPECT_TRUE(content::WaitForLoadStop(contents));
+    std::string title;
+    EXPECT_TRUE(
+        ExecuteScriptAndExtractString(contents,
+                                      "window.domAutomationController.send("
+                                      "document.title)",
+                                      &title));
+    return title;
+  }
+
+ private:
+  base::ScopedTempDir temp_dir_;
 };
 
 // Ensure the site specific script service properly clears its cache of
@@ -250,3 +319,136 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ScriptInjectionWithPrecondition) {
   // Greaselion rule is active
   EXPECT_EQ(title, "Altered");
 }
+
+// A rule which hasn't changed keeps the extension that is already installed
+// when the rules are updated.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, UnchangedRuleKeepsExtension) {
+  ASSERT_TRUE(InstallMockExtension());
+  // Held so that a reinstalled extension can't reuse its address
+  scoped_refptr<const Extension> extension =
+      GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(extension);
+
+  ASSERT_TRUE(InstallMockExtension());
+  EXPECT_EQ(extension.get(), GetGreaselionExtension(kTestRuleName));
+  EXPECT_EQ(GetTitleOfPage("www.a.com"), "Altered");
+}
+
+// A rule whose script has changed is converted again and reinstalled under
+// the same extension id.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ChangedScriptIsReinstalled) {
+  ASSERT_TRUE(InstallMockExtension());
+  scoped_refptr<const Extension> extension =
+      GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(extension);
+
+  base::FilePath rules_dir = CopyTestRules();
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    const std::string script = "document.title = \"Changed\";";
+    ASSERT_EQ(base::WriteFile(rules_dir.AppendASCII("1")
+                                  .AppendASCII("scripts")
+                                  .AppendASCII("a-com.js"),
+                              script.data(), script.size()),
+              static_cast<int>(script.size()));
+  }
+  LoadRules(rules_dir);
+
+  const Extension* updated_extension = GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(updated_extension);
+  EXPECT_NE(extension.get(), updated_extension);
+  EXPECT_EQ(extension->id(), updated_extension->id());
+  EXPECT_NE(extension->path(), updated_extension->path());
+  EXPECT_EQ(GetTitleOfPage("www.a.com"), "Changed");
+}
+
+// The extension for a rule which no longer matches is unloaded, and the other
+// extensions are kept.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, RuleThatStopsMatchingIsUnloaded) {
+  ASSERT_TRUE(InstallMockExtension());
+  EXPECT_FALSE(GetGreaselionExtension(kRewardsRuleName));
+  scoped_refptr<const Extension> extension =
+      GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(extension);
+
+  SetRewardsEnabled(true);
+  EXPECT_TRUE(GetGreaselionExtension(kRewardsRuleName));
+  EXPECT_EQ(GetTitleOfPage("pre1.example.com"), "Altered");
+
+  SetRewardsEnabled(false);
+  EXPECT_FALSE(GetGreaselionExtension(kRewardsRuleName));
+  EXPECT_EQ(extension.get(), GetGreaselionExtension(kTestRuleName));
+  EXPECT_EQ(GetTitleOfPage("pre1.example.com"), "OK");
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       PRE_CachedExtensionIsReusedAfterRestart) {
+  ASSERT_TRUE(InstallMockExtension());
+  const Extension* extension = GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(extension);
+  EXPECT_EQ(GetCacheDir(), extension->path().DirName());
+
+  // Left in the cached extension to tell whether it is converted again
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  ASSERT_EQ(base::WriteFile(extension->path().AppendASCII("marker"), "", 0),
+            0);
+}
+
+// An extension converted in an earlier session is loaded from the cache
+// rather than being converted again.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       CachedExtensionIsReusedAfterRestart) {
+  LoadRules(GetTestRulesDir());
+
+  const Extension* extension = GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(extension);
+  EXPECT_EQ(GetCacheDir(), extension->path().DirName());
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    EXPECT_TRUE(base::PathExists(extension->path().AppendASCII("marker")));
+  }
+  EXPECT_EQ(GetTitleOfPage("www.a.com"), "Altered");
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       PRE_CorruptCachedExtensionIsConvertedAgain) {
+  ASSERT_TRUE(InstallMockExtension());
+  ASSERT_TRUE(GetGreaselionExtension(kTestRuleName));
+}
+
+// A cached extension which can't be loaded is converted again into the same
+// cache directory.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       CorruptCachedExtensionIsConvertedAgain) {
+  std::vector<base::FilePath> manifest_paths;
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    base::FileEnumerator enumerator(GetCacheDir(), false,
+                                    base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      const base::FilePath manifest_path =
+          path.Append(extensions::kManifestFilename);
+      const std::string corrupt_manifest = "{";
+      ASSERT_EQ(base::WriteFile(manifest_path, corrupt_manifest.data(),
+                                corrupt_manifest.size()),
+                static_cast<int>(corrupt_manifest.size()));
+      manifest_paths.push_back(manifest_path);
+    }
+  }
+  ASSERT_FALSE(manifest_paths.empty());
+
+  LoadRules(GetTestRulesDir());
+
+  const Extension* extension = GetGreaselionExtension(kTestRuleName);
+  ASSERT_TRUE(extension);
+  EXPECT_EQ(GetCacheDir(), extension->path().DirName());
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    std::string manifest;
+    ASSERT_TRUE(base::ReadFileToString(
+        extension->path().Append(extensions::kManifestFilename), &manifest));
+    EXPECT_NE(manifest, "{");
+  }
+  EXPECT_EQ(GetTitleOfPage("www.a.com"), "Altered");
+}
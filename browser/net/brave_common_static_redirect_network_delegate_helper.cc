@@ -11,9 +11,11 @@
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "brave/common/brave_features.h"
 #include "brave/common/brave_switches.h"
 #include "brave/common/network_constants.h"
+#include "brave/common/url_pattern_host_index.h"
 #include "components/component_updater/component_updater_url_constants.h"
 #include "extensions/buildflags/buildflags.h"
 #include "extensions/common/url_pattern.h"
@@ -24,25 +26,52 @@
 
 namespace brave {
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+namespace {
+
+// Positions in the index returned by |GetCommonStaticRedirectPatterns|, in the
+// order the rules are checked.
+enum CommonStaticRedirectRule {
+  // Update server checks happen from the profile context for admin policy
+  // installed extensions. Update server checks happen from the system context
+  // for normal update operations.
+  kUpdaterDefault = 0,
+  kUpdaterFallback,
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  kUpdaterWebstore,
+#endif
+  kChromeCast,
+  kClients4,
+};
+
+URLPatternHostIndex BuildCommonStaticRedirectPatterns() {
+  URLPatternHostIndex patterns;
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS,
+      std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP,
+      std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"));
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS,
+      std::string(extension_urls::kChromeWebstoreUpdateURL) + "*"));
 #endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kChromeCastPrefix));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kClients4Prefix),
+               URLPatternHostIndex::MatchType::kHost);
+  return patterns;
+}
+
+const URLPatternHostIndex& GetCommonStaticRedirectPatterns() {
+  static const base::NoDestructor<URLPatternHostIndex> patterns(
+      BuildCommonStaticRedirectPatterns());
+  return *patterns;
+}
+
+}  // namespace
+
+bool IsUpdaterURL(const GURL& gurl) {
+  const size_t rule = GetCommonStaticRedirectPatterns().FindFirstMatch(gurl);
+  return rule != URLPatternHostIndex::kNoMatch && rule < kChromeCast;
 }
 
 int OnBeforeURLRequest_CommonStaticRedirectWork(
@@ -63,42 +92,41 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
   DCHECK(new_url);
 
   GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-
-  if (IsUpdaterURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    const base::CommandLine& command_line =
-        *base::CommandLine::ForCurrentProcess();
-    if (!command_line.HasSwitch(switches::kUseGoUpdateDev) &&
-        !base::FeatureList::IsEnabled(features::kUseDevUpdaterUrl)) {
-      *new_url = GURL(kBraveUpdatesExtensionsProdEndpoint)
-                            .ReplaceComponents(replacements);
-    } else {
-      *new_url = GURL(kBraveUpdatesExtensionsDevEndpoint)
-                            .ReplaceComponents(replacements);
+  switch (GetCommonStaticRedirectPatterns().FindFirstMatch(request_url)) {
+    case kUpdaterDefault:
+    case kUpdaterFallback:
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+    case kUpdaterWebstore:
+#endif
+    {
+      replacements.SetQueryStr(request_url.query_piece());
+      const base::CommandLine& command_line =
+          *base::CommandLine::ForCurrentProcess();
+      if (!command_line.HasSwitch(switches::kUseGoUpdateDev) &&
+          !base::FeatureList::IsEnabled(features::kUseDevUpdaterUrl)) {
+        *new_url = GURL(kBraveUpdatesExtensionsProdEndpoint)
+                              .ReplaceComponents(replacements);
+      } else {
+        *new_url = GURL(kBraveUpdatesExtensionsDevEndpoint)
+                              .ReplaceComponents(replacements);
+      }
+      return net::OK;
     }
-    return net::OK;
-  }
 
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+    case kChromeCast:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
 
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    case kClients4:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveClients4Proxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
   }
 
   return net::OK;
 }
 
-
 }  // namespace brave
@@ -102,8 +102,12 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::Restart() {
 }
 
 void BraveProxyingURLLoaderFactory::InProgressRequest::UpdateRequestInfo() {
-  // TODO(iefremov): Update |ctx_| here and get rid of multiple spots where
-  // it is refilled.
+  // Filled once for each URL the request visits and then shared by all of its
+  // events, so shields settings are only looked up once per redirect hop.
+  ctx_ = std::make_shared<brave::BraveRequestInfo>();
+  brave::BraveRequestInfo::FillCTX(request_, render_process_id_,
+                                   frame_tree_node_id_, request_id_,
+                                   browser_context_, ctx_);
 }
 
 void BraveProxyingURLLoaderFactory::InProgressRequest::RestartInternal() {
@@ -114,10 +118,7 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::RestartInternal() {
       base::BindRepeating(&InProgressRequest::ContinueToBeforeSendHeaders,
                           weak_factory_.GetWeakPtr());
   redirect_url_ = GURL();
-  ctx_ = std::make_shared<brave::BraveRequestInfo>();
-  brave::BraveRequestInfo::FillCTX(request_, render_process_id_,
-                                   frame_tree_node_id_, request_id_,
-                                   browser_context_, ctx_);
+  ctx_->ResetEventResults();
   int result = factory_->request_handler_->OnBeforeURLRequest(
       ctx_, continuation, &redirect_url_);
 
@@ -327,6 +328,7 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
   DCHECK(ctx_);
   if (!ctx_->new_referrer.is_empty()) {
     request_.referrer = ctx_->new_referrer;
+    ctx_->referrer = request_.referrer;
   }
 
   if (proxied_client_receiver_.is_bound())
@@ -376,10 +378,7 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
     auto continuation = base::BindRepeating(
         &InProgressRequest::ContinueToSendHeaders, weak_factory_.GetWeakPtr());
 
-    ctx_ = std::make_shared<brave::BraveRequestInfo>();
-    brave::BraveRequestInfo::FillCTX(request_, render_process_id_,
-                                     frame_tree_node_id_, request_id_,
-                                     browser_context_, ctx_);
+    ctx_->ResetEventResults();
     int result = factory_->request_handler_->OnBeforeStartTransaction(
         ctx_, continuation, &request_.headers);
 
@@ -546,10 +545,8 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
   net::CompletionRepeatingCallback copyable_callback =
       base::AdaptCallbackForRepeating(std::move(continuation));
   if (request_.url.SchemeIsHTTPOrHTTPS()) {
-    ctx_ = std::make_shared<brave::BraveRequestInfo>();
-    brave::BraveRequestInfo::FillCTX(request_, render_process_id_,
-                                     frame_tree_node_id_, request_id_,
-                                     browser_context_, ctx_);
+    DCHECK(ctx_);
+    ctx_->ResetEventResults();
     int result = factory_->request_handler_->OnHeadersReceived(
         ctx_, copyable_callback, current_response_->headers.get(),
         &override_headers_, &redirect_url_);
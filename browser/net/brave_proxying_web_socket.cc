@@ -85,6 +85,8 @@ void BraveProxyingWebSocket::Start() {
         weak_factory_.GetWeakPtr());
   }
 
+  // Filled once and then shared by all of the events of the handshake, like
+  // the context of a proxied URL loader request.
   ctx_ = std::make_shared<brave::BraveRequestInfo>();
   brave::BraveRequestInfo::FillCTX(request_, process_id_,
                                    frame_tree_node_id_, request_id_,
@@ -156,10 +158,8 @@ void BraveProxyingWebSocket::ContinueToHeadersReceived() {
   auto continuation = base::BindRepeating(
       &BraveProxyingWebSocket::OnHeadersReceivedComplete,
       weak_factory_.GetWeakPtr());
-  ctx_ = std::make_shared<brave::BraveRequestInfo>();
-  brave::BraveRequestInfo::FillCTX(request_, process_id_,
-                                   frame_tree_node_id_, request_id_,
-                                   browser_context_, ctx_);
+  DCHECK(ctx_);
+  ctx_->ResetEventResults();
   int result = request_handler_->OnHeadersReceived(
       ctx_, continuation, response_.headers.get(),
       &override_headers_, &redirect_url_);
@@ -266,10 +266,8 @@ void BraveProxyingWebSocket::OnBeforeSendHeadersCompleteFromProxy(
       &BraveProxyingWebSocket::OnBeforeSendHeadersComplete,
       weak_factory_.GetWeakPtr());
 
-  ctx_ = std::make_shared<brave::BraveRequestInfo>();
-  brave::BraveRequestInfo::FillCTX(request_, process_id_,
-                                   frame_tree_node_id_, request_id_,
-                                   browser_context_, ctx_);
+  DCHECK(ctx_);
+  ctx_->ResetEventResults();
   int result = request_handler_->OnBeforeStartTransaction(
       ctx_, continuation, &request_.headers);
 
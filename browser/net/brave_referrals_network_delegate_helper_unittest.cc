@@ -11,6 +11,7 @@
 #include "base/json/json_reader.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 #include "url/url_constants.h"
@@ -63,7 +64,9 @@ TEST(BraveReferralsNetworkDelegateHelperTest, ReplaceHeadersForMatchingDomain) {
 
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
-  request_info->referral_headers_list = referral_headers_list;
+  const brave::ReferralHeadersMatcher referral_headers_matcher(
+      *referral_headers_list);
+  request_info->referral_headers_matcher = &referral_headers_matcher;
 
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
@@ -92,7 +95,9 @@ TEST(BraveReferralsNetworkDelegateHelperTest,
 
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL());
-  request_info->referral_headers_list = referral_headers_list;
+  const brave::ReferralHeadersMatcher referral_headers_matcher(
+      *referral_headers_list);
+  request_info->referral_headers_matcher = &referral_headers_matcher;
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
 
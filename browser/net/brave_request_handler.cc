@@ -28,6 +28,7 @@
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #endif
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
@@ -108,13 +109,16 @@ void BraveRequestHandler::InitPrefChangeRegistrar() {
 #endif
 }
 
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 void BraveRequestHandler::OnReferralHeadersChanged() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   if (const base::ListValue* referral_headers =
           g_browser_process->local_state()->GetList(kReferralHeaders)) {
-    referral_headers_list_.reset(referral_headers->DeepCopy());
+    referral_headers_matcher_ =
+        std::make_unique<brave::ReferralHeadersMatcher>(*referral_headers);
   }
 }
+#endif
 
 bool BraveRequestHandler::IsRequestIdentifierValid(
     uint64_t request_identifier) {
@@ -131,9 +135,7 @@ int BraveRequestHandler::OnBeforeURLRequest(
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeURLRequest_Handler");
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
@@ -143,12 +145,13 @@ int BraveRequestHandler::OnBeforeStartTransaction(
   if (before_start_transaction_callbacks_.empty()) {
     return net::OK;
   }
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeStartTransaction_Handler");
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  ctx->referral_headers_list = referral_headers_list_.get();
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
+  ctx->referral_headers_matcher = referral_headers_matcher_.get();
+#endif
+  return StartCallbacks(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -167,14 +170,12 @@ int BraveRequestHandler::OnHeadersReceived(
     return net::OK;
   }
 
-  callbacks_[ctx->request_identifier] = std::move(callback);
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnHeadersReceived_Handler");
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
-
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx, std::move(callback));
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
@@ -195,8 +196,55 @@ void BraveRequestHandler::RunCallbackForRequestIdentifier(
                  base::BindOnce(std::move(it->second), rv));
 }
 
-// TODO(iefremov): Merge all callback containers into one and run only one loop
-// instead of many (issues/5574).
+int BraveRequestHandler::StartCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // The same |ctx| is used for every event of a request.
+  ctx->next_url_request_index = 0;
+  callbacks_[ctx->request_identifier] = std::move(callback);
+
+  int rv = RunCallbacks(ctx);
+  UMA_HISTOGRAM_BOOLEAN("Brave.RequestHandler.CompletedSynchronously",
+                        rv != net::ERR_IO_PENDING);
+  if (rv == net::ERR_IO_PENDING) {
+    return rv;
+  }
+
+  rv = OnCallbacksComplete(ctx, rv);
+  if (rv != net::OK || ChangedRequest(ctx)) {
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+    return net::ERR_IO_PENDING;
+  }
+
+  // No callback redirected, blocked or rewrote the request, so let the caller
+  // carry on straight away instead of posting the result back to it.
+  callbacks_.erase(ctx->request_identifier);
+  return net::OK;
+}
+
+bool BraveRequestHandler::ChangedRequest(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) const {
+  if (ctx->blocked_by != brave::kNotBlocked ||
+      !ctx->new_referrer.is_empty()) {
+    return true;
+  }
+
+  switch (ctx->event_type) {
+    case brave::kOnBeforeRequest:
+      return ctx->new_url && !ctx->new_url->is_empty();
+    case brave::kOnBeforeStartTransaction:
+      return !ctx->set_headers.empty() || !ctx->removed_headers.empty();
+    case brave::kOnHeadersReceived:
+      return (ctx->override_response_headers &&
+              *ctx->override_response_headers) ||
+             (ctx->allowed_unsafe_redirect_url &&
+              !ctx->allowed_unsafe_redirect_url->is_empty());
+    default:
+      return false;
+  }
+}
+
 void BraveRequestHandler::RunNextCallback(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -205,6 +253,19 @@ void BraveRequestHandler::RunNextCallback(
     return;
   }
 
+  const int rv = RunCallbacks(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return;
+  }
+
+  RunCallbackForRequestIdentifier(ctx->request_identifier,
+                                  OnCallbacksComplete(ctx, rv));
+}
+
+// TODO(iefremov): Merge all callback containers into one and run only one loop
+// instead of many (issues/5574).
+int BraveRequestHandler::RunCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
 
@@ -218,9 +279,6 @@ void BraveRequestHandler::RunNextCallback(
           weak_factory_.GetWeakPtr(),
           ctx);
       rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
       if (rv != net::OK) {
         break;
       }
@@ -235,9 +293,6 @@ void BraveRequestHandler::RunNextCallback(
           weak_factory_.GetWeakPtr(),
           ctx);
       rv = callback.Run(ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
       if (rv != net::OK) {
         break;
       }
@@ -253,18 +308,20 @@ void BraveRequestHandler::RunNextCallback(
       rv = callback.Run(ctx->original_response_headers,
                         ctx->override_response_headers,
                         ctx->allowed_unsafe_redirect_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
       if (rv != net::OK) {
         break;
       }
     }
   }
 
+  return rv;
+}
+
+int BraveRequestHandler::OnCallbacksComplete(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    int rv) {
   if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
+    return rv;
   }
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
@@ -275,11 +332,10 @@ void BraveRequestHandler::RunNextCallback(
     }
     if (ctx->blocked_by == brave::kAdBlocked) {
       if (ctx->cancel_request_explicitly) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_ABORTED);
-        return;
+        return net::ERR_ABORTED;
       }
     }
   }
-  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+
+  return net::OK;
 }
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "brave/browser/net/url_context.h"
+#include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/completion_once_callback.h"
 
@@ -48,11 +49,30 @@ class BraveRequestHandler {
  private:
   void SetupCallbacks();
   void InitPrefChangeRegistrar();
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   void OnReferralHeadersChanged();
+#endif
   void OnPreferenceChanged(const std::string& pref_name);
   void UpdateAdBlockFromPref(const std::string& pref_name);
 
+  // Registers |callback| for |ctx| and runs the callbacks for its event type.
+  // Returns net::OK if they all finished synchronously without changing the
+  // outcome of the request, in which case |callback| is not run. Otherwise
+  // returns net::ERR_IO_PENDING and |callback| is run with the result later.
+  int StartCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                     net::CompletionOnceCallback callback);
+  // Whether the callbacks redirected, blocked or rewrote the headers of the
+  // request during the current event.
+  bool ChangedRequest(std::shared_ptr<brave::BraveRequestInfo> ctx) const;
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Runs the callbacks for |ctx->event_type| starting at
+  // |ctx->next_url_request_index|. Returns net::ERR_IO_PENDING if one of
+  // them is still running, otherwise the result of the last one.
+  int RunCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Applies the changes the callbacks made to |ctx| once they have all run
+  // and returns the result to report for the event.
+  int OnCallbacksComplete(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                          int rv);
 
   std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
@@ -64,7 +84,9 @@ class BraveRequestHandler {
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
+  std::unique_ptr<brave::ReferralHeadersMatcher> referral_headers_matcher_;
+#endif
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
@@ -9,10 +9,9 @@
 #include <string>
 #include <vector>
 
-#include "base/lazy_instance.h"
 #include "base/metrics/histogram_macros.h"
-#include "base/no_destructor.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
@@ -24,7 +23,6 @@
 #include "content/public/common/referrer.h"
 #include "extensions/common/url_pattern.h"
 #include "net/url_request/url_request.h"
-#include "third_party/re2/src/re2/re2.h"
 
 using content::BrowserThread;
 using content::Referrer;
@@ -33,41 +31,36 @@ namespace brave {
 
 namespace {
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
-      std::vector<std::string>({"fbclid", "gclid", "msclkid", "mc_eid"}), "|"));
-  return *trackers;
-}
+// Parameter names are compared case-insensitively.
+constexpr base::StringPiece kQueryStringTrackers[] = {
+  "fbclid", "gclid", "msclkid", "mc_eid"
+};
+
+// The shortest and longest names in |kQueryStringTrackers|, used to reject
+// most parameters without comparing them to every tracker.
+constexpr size_t kMinQueryStringTrackerLength = 5;
+constexpr size_t kMaxQueryStringTrackerLength = 7;
+
+// Returns true for a "name=value" parameter whose name is a tracker and whose
+// value is not empty, e.g. "fbclid=1234" but not "fbclid=" or "fbclid".
+bool IsQueryStringTracker(base::StringPiece param) {
+  const size_t name_length = param.find('=');
+  if (name_length == base::StringPiece::npos ||
+      name_length < kMinQueryStringTrackerLength ||
+      name_length > kMaxQueryStringTrackerLength ||
+      name_length + 1 == param.size()) {
+    return false;
+  }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
+  const base::StringPiece name = param.substr(0, name_length);
+  for (const auto& tracker : kQueryStringTrackers) {
+    if (base::EqualsCaseInsensitiveASCII(name, tracker)) {
+      return true;
+    }
+  }
+
+  return false;
+}
 
 bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
   GURL target_origin = ctx->request_url.GetOrigin();
@@ -93,23 +86,58 @@ void ApplyPotentialQueryStringFilter(const GURL& request_url,
                                      std::string* new_url_spec) {
   DCHECK(new_url_spec);
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
-  std::string new_query = request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
-
-  if (replacement_count > 0) {
-    url::Replacements<char> replacements;
-    if (new_query.empty()) {
-      replacements.ClearQuery();
-    } else {
-      replacements.SetQuery(new_query.c_str(),
-                            url::Component(0, new_query.size()));
+  // Drops every tracker parameter and joins the remaining parameters with
+  // "&" again, so the rest of the query is kept exactly as it was. Nothing
+  // is copied until the first tracker is found.
+  const base::StringPiece query = request_url.query_piece();
+  std::string new_query;
+  bool found_tracker = false;
+  bool kept_param = false;
+  size_t param_start = 0;
+  while (true) {
+    size_t param_end = query.find('&', param_start);
+    if (param_end == base::StringPiece::npos) {
+      param_end = query.size();
+    }
+
+    const base::StringPiece param =
+        query.substr(param_start, param_end - param_start);
+    if (IsQueryStringTracker(param)) {
+      if (!found_tracker) {
+        found_tracker = true;
+        new_query.reserve(query.size());
+        // Keep everything before the first tracker, without its separator.
+        if (param_start > 0) {
+          new_query.assign(query.data(), param_start - 1);
+          kept_param = true;
+        }
+      }
+    } else if (found_tracker) {
+      if (kept_param) {
+        new_query += '&';
+      }
+      param.AppendToString(&new_query);
+      kept_param = true;
+    }
+
+    if (param_end == query.size()) {
+      break;
     }
-    *new_url_spec = request_url.ReplaceComponents(replacements).spec();
+    param_start = param_end + 1;
+  }
+
+  if (!found_tracker) {
+    return;
+  }
+
+  url::Replacements<char> replacements;
+  if (new_query.empty()) {
+    replacements.ClearQuery();
+  } else {
+    replacements.SetQuery(new_query.c_str(),
+                          url::Component(0, new_query.size()));
   }
+  *new_url_spec = request_url.ReplaceComponents(replacements).spec();
 }
 
 }  // namespace
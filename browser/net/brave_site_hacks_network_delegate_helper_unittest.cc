@@ -10,12 +10,51 @@
 #include <utility>
 #include <vector>
 
+#include "base/strings/string_util.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/re2/src/re2/re2.h"
 
 using brave::ResponseCallback;
 
+namespace {
+
+// The regular expression based filter the query string filter replaced, kept
+// as a reference for its behaviour.
+std::string FilterQueryStringWithRegex(const GURL& url) {
+  const std::string trackers = base::JoinString(
+      std::vector<std::string>({"fbclid", "gclid", "msclkid", "mc_eid"}), "|");
+  re2::RE2::Options options;
+  options.set_case_sensitive(false);
+  const re2::RE2 tracker_only_matcher(
+      "^(" + trackers + ")=[^&]+$", options);
+  const re2::RE2 tracker_first_matcher(
+      "^(" + trackers + ")=[^&]+&", options);
+  const re2::RE2 tracker_appended_matcher(
+      "&(" + trackers + ")=[^&]+", options);
+
+  std::string new_query = url.query();
+  const int replacement_count =
+      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher, "") +
+      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher, "") +
+      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher, "");
+  if (replacement_count == 0) {
+    return std::string();
+  }
+
+  url::Replacements<char> replacements;
+  if (new_query.empty()) {
+    replacements.ClearQuery();
+  } else {
+    replacements.SetQuery(new_query.c_str(),
+                          url::Component(0, new_query.size()));
+  }
+  return url.ReplaceComponents(replacements).spec();
+}
+
+}  // namespace
+
 TEST(BraveSiteHacksNetworkDelegateHelperTest, UAWhitelistedTest) {
   const std::vector<const GURL> urls(
       {GURL("https://adobe.com"), GURL("https://adobe.com/something"),
@@ -217,3 +256,37 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
     EXPECT_EQ(brave_request_info->new_url_spec, pair.second);
   }
 }
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFilterMatchesRegex) {
+  const std::vector<std::string> params({
+      "", "fbclid=1", "gclid=abc", "msclkid=a=b", "mc_eid=%20", "FBCLID=1",
+      "GcLiD=2", "fbclid=", "fbclid", "=fbclid", "fbclid==", "xfbclid=1",
+      "fbclidx=1", "mc_eidmc_eid=1", "foo=1", "bar", "?foo=1", "+", "a=b=c",
+  });
+
+  // Every query of up to three parameters, plus a leading and trailing "&".
+  std::vector<std::string> queries;
+  for (const auto& first : params) {
+    for (const auto& second : params) {
+      for (const auto& third : params) {
+        const std::string query = first + "&" + second + "&" + third;
+        queries.push_back(first);
+        queries.push_back(first + "&" + second);
+        queries.push_back(query);
+        queries.push_back("&" + query);
+        queries.push_back(query + "&");
+      }
+    }
+  }
+
+  for (const auto& query : queries) {
+    const GURL url("https://example.com/path?" + query + "#fbclid=1");
+    auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+    int rc = brave::OnBeforeURLRequest_SiteHacksWork(ResponseCallback(),
+                                                     brave_request_info);
+    EXPECT_EQ(rc, net::OK);
+    EXPECT_EQ(brave_request_info->new_url_spec,
+              FilterQueryStringWithRegex(url))
+        << url.spec();
+  }
+}
@@ -8,13 +8,77 @@
 #include <memory>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
+#include "brave/common/url_pattern_host_index.h"
 #include "extensions/common/url_pattern.h"
 
 namespace brave {
 
+namespace {
+
+// Positions in the index returned by |GetStaticRedirectPatterns|, in the order
+// the rules are checked.
+enum StaticRedirectRule {
+  kGeoLocation = 0,
+  kSafeBrowsing,
+  kSafeBrowsingFileCheck,
+  kCRXDownload,
+  kAutofill,
+  kCRLSet1,
+  kCRLSet2,
+  kCRLSet3,
+  kCRLSet4,
+  kGvt1,
+  kGoogleDl,
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  kTranslate,
+  kTranslateLanguage,
+#endif
+};
+
+URLPatternHostIndex BuildStaticRedirectPatterns() {
+  URLPatternHostIndex patterns;
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+               URLPatternHostIndex::MatchType::kHost);
+  patterns.Add(
+      URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix),
+      URLPatternHostIndex::MatchType::kHost);
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kCRXDownloadPrefix));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kCRLSetPrefix1));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kCRLSetPrefix2));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kCRLSetPrefix3));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          kCRLSetPrefix4));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          "*://*.gvt1.com/*"));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                          "*://dl.google.com/*"));
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS,
+                          kTranslateElementJSPattern));
+  patterns.Add(URLPattern(URLPattern::SCHEME_HTTPS,
+                          kTranslateLanguagePattern));
+#endif
+  return patterns;
+}
+
+const URLPatternHostIndex& GetStaticRedirectPatterns() {
+  static const base::NoDestructor<URLPatternHostIndex> patterns(
+      BuildStaticRedirectPatterns());
+  return *patterns;
+}
+
+}  // namespace
+
 int OnBeforeURLRequest_StaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -31,127 +95,67 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
   GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingFileCheckPrefix);
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
+  switch (GetStaticRedirectPatterns().FindFirstMatch(request_url)) {
+    case kGeoLocation:
+      *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+      return net::OK;
+
+    case kSafeBrowsing:
+      replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+
+    case kSafeBrowsingFileCheck:
+      // TODO(@fmarier): Re-enable download protection once we have
+      // truncated the list of metadata that it sends to the server
+      // (brave/brave-browser#6267).
+      //
+      // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
+      // *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+
+    case kCRXDownload:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crxdownload.brave.com");
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+
+    case kAutofill:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveStaticProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+
+    case kCRLSet1:
+    case kCRLSet2:
+    case kCRLSet3:
+    case kCRLSet4:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crlsets.brave.com");
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+
+    case kGvt1:
+    case kGoogleDl:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
+    case kTranslate:
+      replacements.SetQueryStr(request_url.query_piece());
+      replacements.SetPathStr(request_url.path_piece());
+      *new_url =
+        GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
+      return net::OK;
+
+    case kTranslateLanguage:
+      *new_url = GURL(kBraveTranslateLanguageEndpoint);
+      return net::OK;
 #endif
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
   }
 
-  if (safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    // TODO(@fmarier): Re-enable download protection once we have
-    // truncated the list of metadata that it sends to the server
-    // (brave/brave-browser#6267).
-    //
-    // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
-    // *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (gvt1_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (googleDl_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    replacements.SetPathStr(request_url.path_piece());
-    *new_url =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (translate_language_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
-  }
-#endif
-
   return net::OK;
 }
 
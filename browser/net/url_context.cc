@@ -42,6 +42,16 @@ BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
 
 BraveRequestInfo::~BraveRequestInfo() = default;
 
+void BraveRequestInfo::ResetEventResults() {
+  new_url_spec.clear();
+  new_referrer = GURL();
+  set_headers.clear();
+  removed_headers.clear();
+  blocked_by = kNotBlocked;
+  cancel_request_explicitly = false;
+  mock_data_url.clear();
+}
+
 // static
 void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                                int render_process_id,
@@ -25,6 +25,7 @@ struct ResourceRequest;
 }
 
 namespace brave {
+class ReferralHeadersMatcher;
 struct BraveRequestInfo;
 using ResponseCallback = base::Callback<void()>;
 }  // namespace brave
@@ -87,7 +88,7 @@ struct BraveRequestInfo {
 
   GURL* allowed_unsafe_redirect_url = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
-  const base::ListValue* referral_headers_list = nullptr;
+  const ReferralHeadersMatcher* referral_headers_matcher = nullptr;
   BlockedBy blocked_by = kNotBlocked;
   bool cancel_request_explicitly = false;
   std::string mock_data_url;
@@ -102,6 +103,10 @@ struct BraveRequestInfo {
 
   std::string upload_data;
 
+  // Clears what the callbacks of the previous event decided, so that the same
+  // context can be passed to the next event of the request.
+  void ResetEventResults();
+
   static void FillCTX(const network::ResourceRequest& request,
                       int render_process_id,
                       int frame_tree_node_id,
@@ -6,10 +6,13 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+// |generation| changes each time the rules are received from the browser, so
+// renderers can tell when rules which are updated in place have changed.
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  int generation = 0;
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
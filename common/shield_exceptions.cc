@@ -9,23 +9,33 @@
 #include <map>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/common/url_pattern_host_index.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 namespace brave {
 
+namespace {
+
+URLPatternHostIndex BuildUAWhitelistPatterns() {
+  URLPatternHostIndex patterns;
+  patterns.Add(URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"));
+  patterns.Add(
+      URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"));
+  patterns.Add(URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"));
+  // For Widevine
+  patterns.Add(URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*"));
+  return patterns;
+}
+
+}  // namespace
+
 bool IsUAWhitelisted(const GURL& gurl) {
-  static std::vector<URLPattern> whitelist_patterns({
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
-    // For Widevine
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")
-  });
-  return std::any_of(whitelist_patterns.begin(), whitelist_patterns.end(),
-      [&gurl](URLPattern pattern){
-        return pattern.MatchesURL(gurl);
-      });
+  static const base::NoDestructor<URLPatternHostIndex> whitelist_patterns(
+      BuildUAWhitelistPatterns());
+  return whitelist_patterns->FindFirstMatch(gurl) !=
+      URLPatternHostIndex::kNoMatch;
 }
 
 bool IsBlockedResource(const GURL& gurl) {
@@ -0,0 +1,129 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_pattern_host_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "base/logging.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+// Matches the canonicalization |URLPattern::MatchesHost| applies to both
+// hosts, so "example.com." and "example.com" share an index entry.
+base::StringPiece CanonicalizeHost(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.') {
+    host.remove_suffix(1);
+  }
+  return host;
+}
+
+}  // namespace
+
+const size_t URLPatternHostIndex::kNoMatch =
+    std::numeric_limits<size_t>::max();
+
+URLPatternHostIndex::URLPatternHostIndex() = default;
+
+URLPatternHostIndex::URLPatternHostIndex(URLPatternHostIndex&& other) =
+    default;
+
+URLPatternHostIndex& URLPatternHostIndex::operator=(
+    URLPatternHostIndex&& other) = default;
+
+URLPatternHostIndex::~URLPatternHostIndex() = default;
+
+size_t URLPatternHostIndex::Add(const URLPattern& pattern,
+                                MatchType match_type) {
+  const size_t position = patterns_.size();
+  patterns_.push_back({pattern, match_type});
+
+  const std::string host = CanonicalizeHost(pattern.host()).as_string();
+  if (pattern.match_subdomains()) {
+    if (host.empty()) {
+      any_host_.push_back(position);
+    } else {
+      subdomain_hosts_[host].push_back(position);
+    }
+  } else {
+    exact_hosts_[host].push_back(position);
+  }
+
+  return position;
+}
+
+size_t URLPatternHostIndex::FindFirstMatch(const GURL& url) const {
+  std::vector<size_t> candidates(any_host_);
+  AddCandidatesForHost(url.host_piece(), &candidates);
+  // |URLPattern::MatchesURL| matches filesystem: URLs against their inner URL.
+  if (url.SchemeIsFileSystem() && url.inner_url()) {
+    AddCandidatesForHost(url.inner_url()->host_piece(), &candidates);
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+
+  for (const size_t position : candidates) {
+    if (Matches(patterns_[position], url)) {
+      return position;
+    }
+  }
+
+  return kNoMatch;
+}
+
+void URLPatternHostIndex::AddCandidatesForHost(
+    base::StringPiece host,
+    std::vector<size_t>* candidates) const {
+  host = CanonicalizeHost(host);
+
+  const std::string host_string = host.as_string();
+  auto exact_it = exact_hosts_.find(host_string);
+  if (exact_it != exact_hosts_.end()) {
+    candidates->insert(candidates->end(), exact_it->second.begin(),
+                       exact_it->second.end());
+  }
+
+  if (subdomain_hosts_.empty()) {
+    return;
+  }
+
+  // Look up the host itself and every parent domain, e.g. "a.b.com",
+  // "b.com" and "com".
+  size_t offset = 0;
+  while (offset < host.size()) {
+    auto it = subdomain_hosts_.find(host.substr(offset).as_string());
+    if (it != subdomain_hosts_.end()) {
+      candidates->insert(candidates->end(), it->second.begin(),
+                         it->second.end());
+    }
+
+    const size_t dot = host.find('.', offset);
+    if (dot == base::StringPiece::npos) {
+      break;
+    }
+    offset = dot + 1;
+  }
+}
+
+bool URLPatternHostIndex::Matches(const Entry& entry, const GURL& url) const {
+  switch (entry.match_type) {
+    case MatchType::kURL:
+      return entry.pattern.MatchesURL(url);
+    case MatchType::kHost:
+      return entry.pattern.MatchesHost(url);
+  }
+
+  NOTREACHED();
+  return false;
+}
+
+}  // namespace brave
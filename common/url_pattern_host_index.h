@@ -0,0 +1,77 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMMON_URL_PATTERN_HOST_INDEX_H_
+#define BRAVE_COMMON_URL_PATTERN_HOST_INDEX_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// Indexes a fixed list of URLPatterns by host, so that finding the first
+// pattern which matches a URL only tests the patterns whose host could match
+// instead of every pattern in turn.
+class URLPatternHostIndex {
+ public:
+  enum class MatchType {
+    // Matches using |URLPattern::MatchesURL|.
+    kURL,
+    // Matches using |URLPattern::MatchesHost|.
+    kHost,
+  };
+
+  static const size_t kNoMatch;
+
+  URLPatternHostIndex();
+  URLPatternHostIndex(URLPatternHostIndex&& other);
+  URLPatternHostIndex& operator=(URLPatternHostIndex&& other);
+  ~URLPatternHostIndex();
+
+  // Returns the position of the added pattern. Positions are assigned in the
+  // order patterns are added, starting from 0.
+  size_t Add(const URLPattern& pattern,
+             MatchType match_type = MatchType::kURL);
+
+  // Returns the position of the first added pattern which matches |url|, or
+  // |kNoMatch| if none of them do.
+  size_t FindFirstMatch(const GURL& url) const;
+
+  bool empty() const { return patterns_.empty(); }
+  size_t size() const { return patterns_.size(); }
+
+ private:
+  struct Entry {
+    URLPattern pattern;
+    MatchType match_type;
+  };
+
+  using HostMap = std::unordered_map<std::string, std::vector<size_t>>;
+
+  void AddCandidatesForHost(base::StringPiece host,
+                            std::vector<size_t>* candidates) const;
+  bool Matches(const Entry& entry, const GURL& url) const;
+
+  std::vector<Entry> patterns_;
+
+  // Patterns which only match a single host.
+  HostMap exact_hosts_;
+  // Patterns which match a host and its subdomains, keyed by that host.
+  HostMap subdomain_hosts_;
+  // Patterns which match any host.
+  std::vector<size_t> any_host_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMMON_URL_PATTERN_HOST_INDEX_H_
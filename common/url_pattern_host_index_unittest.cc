@@ -0,0 +1,201 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_pattern_host_index.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "brave/common/network_constants.h"
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+using brave::URLPatternHostIndex;
+
+struct TestPattern {
+  URLPattern pattern;
+  URLPatternHostIndex::MatchType match_type;
+};
+
+// Same order and match types as the static redirect rules.
+std::vector<TestPattern> GetStaticRedirectTestPatterns() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  return {
+    {URLPattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+        URLPatternHostIndex::MatchType::kHost},
+    {URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix),
+        URLPatternHostIndex::MatchType::kHost},
+    {URLPattern(kHttpOrHttps, kCRXDownloadPrefix),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, kCRLSetPrefix1),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, kCRLSetPrefix2),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, kCRLSetPrefix3),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, kCRLSetPrefix4),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, "*://*.gvt1.com/*"),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, "*://dl.google.com/*"),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, kChromeCastPrefix),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(kHttpOrHttps, kClients4Prefix),
+        URLPatternHostIndex::MatchType::kHost},
+    {URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
+        URLPatternHostIndex::MatchType::kURL},
+    {URLPattern(URLPattern::SCHEME_ALL, "<all_urls>"),
+        URLPatternHostIndex::MatchType::kHost},
+  };
+}
+
+std::vector<std::string> GetTestURLs() {
+  return {
+    "https://www.googleapis.com/geolocation/v1/geolocate?key=2_3_4",
+    "https://www.googleapis.com/geolocation/v1/geolocate",
+    "http://www.googleapis.com/geolocation/v1/geolocate?key=2_3_4",
+    "https://safebrowsing.googleapis.com/v4/threatListUpdates",
+    "http://safebrowsing.googleapis.com/v4/threatListUpdates",
+    "https://sb-ssl.google.com/safebrowsing/clientreport/download",
+    "https://clients2.googleusercontent.com/crx/blobs/QgAAAC6/a.crx",
+    "https://www.gstatic.com/autofill/weekly/bla",
+    "https://www.gstatic.com/images/branding/product/1x/translate_24dp.png",
+    "http://dl.google.com/release2/chrome_component/AJ4r388iQSJq_1819/"
+        "1819_all_crl-set-5071.data.crx3",
+    "https://dl.google.com/chrome/mac/stable/GGRO/googlechrome.dmg",
+    "http://r2---sn-n4v7sn7y.gvt1.com/edgedl/release2/chrome_component/"
+        "AJ4r388iQSJq_1819/1819_all_crl-set-5071.data.crx3",
+    "https://gvt1.com/edgedl/release2/chrome_component/abc",
+    "https://redirector.gvt1.com/edgedl/release2/",
+    "https://redirector.gvt1.com./edgedl/",
+    "https://www.google.com/dl/release2/chrome_component/LLjIBPPmveI_1/"
+        "1_all_crl-set-6009.data.crx3",
+    "https://storage.googleapis.com/update-delta/"
+        "hfnkpimlhhgieaddgfemjhofmfblmnib/5.17/5.16/1.crxd",
+    "https://www.gstatic.com/cv/js/sender/v1/cast_sender.js",
+    "https://clients4.google.com/chrome-sync/dev",
+    "https://brave.com/",
+    "https://laptop-updates.brave.com/",
+    "http://laptop-updates.brave.com/",
+    "https://com/",
+    "https://google.com/",
+    "https://127.0.0.1/",
+    "file:///etc/hosts",
+    "filesystem:https://dl.google.com/temporary/a.txt",
+    "data:text/plain,hello",
+    "about:blank",
+  };
+}
+
+size_t FindFirstMatchLinear(const std::vector<TestPattern>& patterns,
+                            const GURL& url) {
+  for (size_t i = 0; i < patterns.size(); i++) {
+    const TestPattern& test_pattern = patterns[i];
+    const bool matches =
+        test_pattern.match_type == URLPatternHostIndex::MatchType::kURL
+            ? test_pattern.pattern.MatchesURL(url)
+            : test_pattern.pattern.MatchesHost(url);
+    if (matches) {
+      return i;
+    }
+  }
+
+  return URLPatternHostIndex::kNoMatch;
+}
+
+}  // namespace
+
+TEST(URLPatternHostIndexTest, EmptyIndex) {
+  URLPatternHostIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(URLPatternHostIndex::kNoMatch,
+            index.FindFirstMatch(GURL("https://brave.com/")));
+}
+
+TEST(URLPatternHostIndexTest, ReturnsFirstMatchingPattern) {
+  URLPatternHostIndex index;
+  EXPECT_EQ(0u, index.Add(URLPattern(URLPattern::SCHEME_ALL,
+                                     "https://www.brave.com/download/*")));
+  EXPECT_EQ(1u, index.Add(URLPattern(URLPattern::SCHEME_ALL,
+                                     "https://*.brave.com/*")));
+  EXPECT_EQ(2u, index.Add(URLPattern(URLPattern::SCHEME_ALL, "*://*/*")));
+  EXPECT_EQ(3u, index.size());
+
+  EXPECT_EQ(0u, index.FindFirstMatch(
+      GURL("https://www.brave.com/download/")));
+  EXPECT_EQ(1u, index.FindFirstMatch(GURL("https://www.brave.com/")));
+  EXPECT_EQ(1u, index.FindFirstMatch(GURL("https://brave.com/")));
+  EXPECT_EQ(2u, index.FindFirstMatch(GURL("http://brave.com/")));
+  EXPECT_EQ(2u, index.FindFirstMatch(GURL("https://notbrave.com/")));
+  EXPECT_EQ(URLPatternHostIndex::kNoMatch,
+            index.FindFirstMatch(GURL("data:text/plain,")));
+}
+
+// Checks the index against testing every pattern in turn, using the static
+// redirect rules over a corpus of browser and update server URLs.
+TEST(URLPatternHostIndexTest, MatchesLinearScan) {
+  const std::vector<TestPattern> patterns = GetStaticRedirectTestPatterns();
+  URLPatternHostIndex index;
+  for (const auto& test_pattern : patterns) {
+    index.Add(test_pattern.pattern, test_pattern.match_type);
+  }
+
+  // Without the catch-all pattern as well, so that URLs can fail to match.
+  const std::vector<TestPattern> patterns_without_catch_all(
+      patterns.begin(), patterns.end() - 1);
+  URLPatternHostIndex index_without_catch_all;
+  for (const auto& test_pattern : patterns_without_catch_all) {
+    index_without_catch_all.Add(test_pattern.pattern, test_pattern.match_type);
+  }
+
+  for (const auto& spec : GetTestURLs()) {
+    const GURL url(spec);
+    EXPECT_EQ(FindFirstMatchLinear(patterns, url), index.FindFirstMatch(url))
+        << spec;
+    EXPECT_EQ(FindFirstMatchLinear(patterns_without_catch_all, url),
+              index_without_catch_all.FindFirstMatch(url))
+        << spec;
+  }
+}
+
+// Referral headers match a few hundred domains and their subdomains.
+TEST(URLPatternHostIndexTest, ManySubdomainPatterns) {
+  const int kDomainCount = 500;
+
+  std::vector<TestPattern> patterns;
+  URLPatternHostIndex index;
+  for (int i = 0; i < kDomainCount; i++) {
+    URLPattern pattern(URLPattern::SCHEME_HTTPS | URLPattern::SCHEME_HTTP);
+    pattern.SetScheme("*");
+    pattern.SetHost("site" + base::NumberToString(i) + ".com");
+    pattern.SetPath("/*");
+    pattern.SetMatchSubdomains(true);
+    index.Add(pattern);
+    patterns.push_back({pattern, URLPatternHostIndex::MatchType::kURL});
+  }
+
+  for (int i = 0; i < kDomainCount * 2; i++) {
+    const std::string host = "site" + base::NumberToString(i) + ".com";
+    for (const auto& spec : {"https://" + host + "/",
+                             "http://www." + host + "/path?query",
+                             "https://a.b." + host + "./",
+                             "ftp://" + host + "/",
+                             "https://not" + host + "/"}) {
+      const GURL url(spec);
+      EXPECT_EQ(FindFirstMatchLinear(patterns, url),
+                index.FindFirstMatch(url))
+          << spec;
+    }
+  }
+}
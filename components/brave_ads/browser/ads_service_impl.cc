@@ -34,6 +34,7 @@
 #include "brave/components/brave_rewards/browser/rewards_p3a.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
+#include "brave/components/brave_rewards/browser/state_file_writer.h"
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
@@ -83,6 +84,11 @@ const char kRewardsNotificationAdsOnboarding[] =
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Client state is saved after nearly every tab event, so writes are coalesced
+// over this interval and committed when the service shuts down
+constexpr base::TimeDelta kClientStateCommitInterval =
+    base::TimeDelta::FromSeconds(30);
+
 }  // namespace
 
 class LogStreamImpl : public ads::LogStream {
@@ -299,6 +305,9 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile) :
     last_idle_state_(ui::IdleState::IDLE_STATE_ACTIVE),
     bundle_state_backend_(new BundleStateDatabase(
         base_path_.AppendASCII("bundle_state"))),
+    client_state_writer_(new brave_rewards::StateFileWriter(
+        base_path_.AppendASCII(ads::_client_resource_name), file_task_runner_,
+        kClientStateCommitInterval)),
     display_service_(NotificationDisplayService::GetForProfile(profile_)),
     rewards_service_(brave_rewards::RewardsServiceFactory::GetForProfile(
         profile_)),
@@ -543,6 +552,10 @@ void AdsServiceImpl::Shutdown() {
 
   idle_poll_timer_.Stop();
 
+  // Write pending client state before the connection to the ads service is
+  // closed. |file_task_runner_| blocks shutdown, so the write completes
+  client_state_writer_->CommitPendingWrite();
+
   bat_ads_.reset();
   bat_ads_client_receiver_.reset();
   bat_ads_service_.reset();
@@ -669,6 +682,8 @@ void AdsServiceImpl::Stop() {
 }
 
 void AdsServiceImpl::ResetAllState() {
+  client_state_writer_->CancelPendingWrite();
+
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ResetOnFileTaskRunner, base_path_),
@@ -1754,6 +1769,7 @@ std::string AdsServiceImpl::GetStringPref(
 void AdsServiceImpl::ResetTheWholeState(
     const base::Callback<void(bool)>& callback) {
   SetEnabled(false);
+  client_state_writer_->CancelPendingWrite();
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ResetOnFileTaskRunner,
@@ -2053,6 +2069,12 @@ void AdsServiceImpl::Save(
     const std::string& name,
     const std::string& value,
     ads::ResultCallback callback) {
+  if (name == ads::_client_resource_name) {
+    client_state_writer_->Save(value, base::BindOnce(&AdsServiceImpl::OnSaved,
+        AsWeakPtr(), std::move(callback)));
+    return;
+  }
+
   base::ImportantFileWriter writer(
       base_path_.AppendASCII(name), file_task_runner_);
 
@@ -2070,6 +2092,10 @@ void AdsServiceImpl::Save(
 void AdsServiceImpl::Load(
     const std::string& name,
     ads::LoadCallback callback) {
+  if (name == ads::_client_resource_name) {
+    client_state_writer_->CommitPendingWrite();
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadOnFileTaskRunner, base_path_.AppendASCII(name)),
       base::BindOnce(&AdsServiceImpl::OnLoaded,
@@ -2080,6 +2106,10 @@ void AdsServiceImpl::Load(
 void AdsServiceImpl::Reset(
     const std::string& name,
     ads::ResultCallback callback) {
+  if (name == ads::_client_resource_name) {
+    client_state_writer_->CancelPendingWrite();
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ResetOnFileTaskRunner, base_path_.AppendASCII(name)),
       base::BindOnce(&AdsServiceImpl::OnReset,
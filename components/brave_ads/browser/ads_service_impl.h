@@ -45,6 +45,7 @@ class SequencedTaskRunner;
 
 namespace brave_rewards {
 class RewardsService;
+class StateFileWriter;
 }  // namespace brave_rewards
 
 namespace network {
@@ -486,6 +487,8 @@ class AdsServiceImpl : public AdsService,
 
   std::unique_ptr<BundleStateDatabase> bundle_state_backend_;
 
+  std::unique_ptr<brave_rewards::StateFileWriter> client_state_writer_;
+
   NotificationDisplayService* display_service_;  // NOT OWNED
   brave_rewards::RewardsService* rewards_service_;  // NOT OWNED
 
@@ -6,6 +6,7 @@
 #include "brave/components/brave_ads/browser/bundle_state_database.h"
 
 #include <stdint.h>
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -26,6 +27,19 @@ namespace {
 const int kCurrentVersionNumber = 4;
 const int kCompatibleVersionNumber = 4;
 
+const char kCategoriesTableName[] = "category";
+const char kCategoriesStagingTableName[] = "category_staging";
+const char kCreativeAdNotificationsTableName[] = "ad_info";
+const char kCreativeAdNotificationsStagingTableName[] = "ad_info_staging";
+const char kCreativeAdNotificationCategoriesTableName[] = "ad_info_category";
+const char kCreativeAdNotificationCategoriesStagingTableName[] =
+    "ad_info_category_staging";
+const char kAdConversionsTableName[] = "ad_conversions";
+const char kAdConversionsStagingTableName[] = "ad_conversions_staging";
+
+// SQLite's default SQLITE_MAX_VARIABLE_NUMBER
+const size_t kMaxVariablesPerStatement = 999;
+
 }  // namespace
 
 BundleStateDatabase::BundleStateDatabase(
@@ -67,11 +81,13 @@ bool BundleStateDatabase::Init() {
     return false;
   }
 
-  if (!CreateCategoriesTable() ||
-      !CreateCreativeAdNotificationsTable() ||
-      !CreateCreativeAdNotificationCategoriesTable() ||
+  if (!CreateCategoriesTable(kCategoriesTableName) ||
+      !CreateCreativeAdNotificationsTable(
+          kCreativeAdNotificationsTableName) ||
+      !CreateCreativeAdNotificationCategoriesTable(
+          kCreativeAdNotificationCategoriesTableName) ||
       !CreateCreativeAdNotificationCategoriesCategoryIndex() ||
-      !CreateAdConversionsTable()) {
+      !CreateAdConversionsTable(kAdConversionsTableName)) {
     return false;
   }
 
@@ -91,15 +107,15 @@ bool BundleStateDatabase::Init() {
   return is_initialized_;
 }
 
-bool BundleStateDatabase::CreateCategoriesTable() {
+bool BundleStateDatabase::CreateCategoriesTable(
+    const char* table_name) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const char table_name[] = "category";
   if (GetDB().DoesTableExist(table_name)) {
     return true;
   }
 
-  // Note: revise implementation for |InsertOrUpdateCategory| if you add any new
+  // Note: revise implementation for |InsertCategories| if you add any new
   // constraints to the schema
   const std::string sql = base::StringPrintf(
       "CREATE TABLE %s "
@@ -109,49 +125,29 @@ bool BundleStateDatabase::CreateCategoriesTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoriesTable() {
+bool BundleStateDatabase::InsertCategories(
+    const char* table_name,
+    const std::vector<std::string>& categories) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql =
-      "DELETE FROM category";
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-  return statement.Run();
-}
-
-bool BundleStateDatabase::InsertOrUpdateCategory(
-    const std::string& category) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql = base::StringPrintf(
-      "INSERT OR REPLACE INTO category "
-          "(name) VALUES (%s)",
-      CreateBindingParameterPlaceholders(1).c_str());
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-  statement.BindString(0, category);
-
-  return statement.Run();
+  return InsertRows(table_name, "name", 1, categories,
+      [](sql::Statement* statement,
+         int index,
+         const std::string& category) {
+    statement->BindString(index, category);
+  });
 }
 
-bool BundleStateDatabase::CreateCreativeAdNotificationsTable() {
+bool BundleStateDatabase::CreateCreativeAdNotificationsTable(
+    const char* table_name) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const char table_name[] = "ad_info";
   if (GetDB().DoesTableExist(table_name)) {
     return true;
   }
 
-  // Note: revise implementation for |InsertOrUpdateCreativeAdNotification| if
-  // you add any new constraints to the schema
+  // Note: revise implementation for |InsertCreativeAdNotifications| if you add
+  // any new constraints to the schema
   const std::string sql = base::StringPrintf(
       "CREATE TABLE %s "
           "(creative_set_id LONGVARCHAR, "
@@ -173,74 +169,50 @@ bool BundleStateDatabase::CreateCreativeAdNotificationsTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCreativeAdNotificationsTable() {
+bool BundleStateDatabase::InsertCreativeAdNotifications(
+    const char* table_name,
+    const std::vector<CreativeAdNotificationRow>& rows) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql =
-      "DELETE FROM ad_info";
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-  return statement.Run();
-}
-
-bool BundleStateDatabase::InsertOrUpdateCreativeAdNotification(
-    const ads::CreativeAdNotificationInfo& info) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  for (const auto& geo_target : info.geo_targets) {
-    const std::string sql = base::StringPrintf(
-        "INSERT OR REPLACE INTO ad_info "
-            "(creative_set_id, "
-            "advertiser, "
-            "notification_text, "
-            "notification_url, "
-            "start_timestamp, "
-            "end_timestamp, "
-            "uuid, "
-            "campaign_id, "
-            "daily_cap, "
-            "advertiser_id, "
-            "per_day, "
-            "total_max, "
-            "region) VALUES (%s)",
-      CreateBindingParameterPlaceholders(13).c_str());
-
-    sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-    statement.BindString(0, info.creative_set_id);
-    statement.BindString(1, info.title);
-    statement.BindString(2, info.body);
-    statement.BindString(3, info.target_url);
-    statement.BindString(4, info.start_at_timestamp);
-    statement.BindString(5, info.end_at_timestamp);
-    statement.BindString(6, info.creative_instance_id);
-    statement.BindString(7, info.campaign_id);
+  return InsertRows(table_name,
+      "creative_set_id, "
+      "advertiser, "
+      "notification_text, "
+      "notification_url, "
+      "start_timestamp, "
+      "end_timestamp, "
+      "uuid, "
+      "campaign_id, "
+      "daily_cap, "
+      "advertiser_id, "
+      "per_day, "
+      "total_max, "
+      "region", 13, rows,
+      [](sql::Statement* statement,
+         int index,
+         const CreativeAdNotificationRow& row) {
+    const ads::CreativeAdNotificationInfo& info = *row.info;
+    statement->BindString(index++, info.creative_set_id);
+    statement->BindString(index++, info.title);
+    statement->BindString(index++, info.body);
+    statement->BindString(index++, info.target_url);
+    statement->BindString(index++, info.start_at_timestamp);
+    statement->BindString(index++, info.end_at_timestamp);
+    statement->BindString(index++, info.creative_instance_id);
+    statement->BindString(index++, info.campaign_id);
     // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast.
-    statement.BindInt64(8, info.daily_cap);
-    statement.BindString(9, info.advertiser_id);
-    statement.BindInt64(10, info.per_day);
-    statement.BindInt64(11, info.total_max);
-    statement.BindString(12, geo_target);
-
-    if (!statement.Run()) {
-      return false;
-    }
-  }
-
-  return true;
+    statement->BindInt64(index++, info.daily_cap);
+    statement->BindString(index++, info.advertiser_id);
+    statement->BindInt64(index++, info.per_day);
+    statement->BindInt64(index++, info.total_max);
+    statement->BindString(index++, *row.geo_target);
+  });
 }
 
-bool BundleStateDatabase::CreateCreativeAdNotificationCategoriesTable() {
+bool BundleStateDatabase::CreateCreativeAdNotificationCategoriesTable(
+    const char* table_name) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const char table_name[] = "ad_info_category";
   if (GetDB().DoesTableExist(table_name)) {
     return true;
   }
@@ -263,40 +235,20 @@ bool BundleStateDatabase::CreateCreativeAdNotificationCategoriesTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCreativeAdNotificationCategoriesTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql =
-      "DELETE FROM ad_info_category";
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-  return statement.Run();
-}
-
-bool BundleStateDatabase::InsertOrUpdateCreativeAdNotificationCategory(
-    const ads::CreativeAdNotificationInfo& info,
-    const std::string& category) {
+bool BundleStateDatabase::InsertCreativeAdNotificationCategories(
+    const char* table_name,
+    const std::vector<CreativeAdNotificationCategoryRow>& rows) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
-
-  const std::string sql = base::StringPrintf(
-      "INSERT OR REPLACE INTO ad_info_category "
-          "(ad_info_uuid, "
-          "category_name) VALUES (%s)",
-      CreateBindingParameterPlaceholders(2).c_str());
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-  statement.BindString(0, info.creative_instance_id);
-  statement.BindString(1, category);
-
-  return statement.Run();
+  return InsertRows(table_name,
+      "ad_info_uuid, "
+      "category_name", 2, rows,
+      [](sql::Statement* statement,
+         int index,
+         const CreativeAdNotificationCategoryRow& row) {
+    statement->BindString(index, row.info->creative_instance_id);
+    statement->BindString(index + 1, *row.category);
+  });
 }
 
 bool
@@ -310,16 +262,16 @@ BundleStateDatabase::CreateCreativeAdNotificationCategoriesCategoryIndex() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::CreateAdConversionsTable() {
+bool BundleStateDatabase::CreateAdConversionsTable(
+    const char* table_name) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const char table_name[] = "ad_conversions";
   if (GetDB().DoesTableExist(table_name)) {
     return true;
   }
 
-  // Note: revise implementation for |InsertOrUpdateAdConversion| if you add any
-  // new constraints to the schema
+  // Note: revise implementation for |InsertAdConversions| if you add any new
+  // constraints to the schema
   const std::string sql = base::StringPrintf(
       "CREATE TABLE %s "
           "(id INTEGER PRIMARY KEY, "
@@ -332,44 +284,108 @@ bool BundleStateDatabase::CreateAdConversionsTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdConversionsTable() {
+bool BundleStateDatabase::InsertAdConversions(
+    const char* table_name,
+    const ads::AdConversionList& ad_conversions) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  return InsertRows(table_name,
+      "creative_set_id, "
+      "type, "
+      "url_pattern, "
+      "observation_window", 4, ad_conversions,
+      [](sql::Statement* statement,
+         int index,
+         const ads::AdConversionInfo& info) {
+    statement->BindString(index, info.creative_set_id);
+    statement->BindString(index + 1, info.type);
+    statement->BindString(index + 2, info.url_pattern);
+    // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast.
+    statement->BindInt64(index + 3, info.observation_window);
+  });
+}
 
-  const std::string sql =
-      "DELETE FROM ad_conversions";
+template <typename Row, typename BindRow>
+bool BundleStateDatabase::InsertRows(
+    const char* table_name,
+    const char* columns,
+    const size_t column_count,
+    const std::vector<Row>& rows,
+    BindRow bind_row) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  DCHECK_GT(column_count, 0u);
+  const size_t max_rows_per_statement =
+      kMaxVariablesPerStatement / column_count;
+
+  size_t offset = 0;
+  while (offset < rows.size()) {
+    const size_t row_count =
+        std::min(rows.size() - offset, max_rows_per_statement);
+
+    std::string values;
+    const std::string row_placeholders = base::StringPrintf("(%s)",
+        CreateBindingParameterPlaceholders(column_count).c_str());
+    for (size_t i = 0; i < row_count; i++) {
+      if (i != 0) {
+        values += ", ";
+      }
+
+      values += row_placeholders;
+    }
+
+    const std::string sql = base::StringPrintf(
+        "INSERT OR REPLACE INTO %s "
+            "(%s) VALUES %s",
+        table_name, columns, values.c_str());
+
+    // Full statements always have the same text for a table, so they are only
+    // compiled once for all the batches of all the saves
+    sql::Statement statement(row_count == max_rows_per_statement ?
+        GetDB().GetCachedStatement(sql::StatementID(table_name), sql.c_str()) :
+        GetDB().GetUniqueStatement(sql.c_str()));
+
+    int index = 0;
+    for (size_t i = 0; i < row_count; i++) {
+      bind_row(&statement, index, rows[offset + i]);
+      index += static_cast<int>(column_count);
+    }
+
+    if (!statement.Run()) {
+      return false;
+    }
 
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
+    offset += row_count;
+  }
 
-  return statement.Run();
+  return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdConversion(
-    const ads::AdConversionInfo& info) {
+bool BundleStateDatabase::DropTable(
+    const char* table_name) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const bool is_initialized = Init();
-  DCHECK(is_initialized);
+  const std::string sql = base::StringPrintf(
+      "DROP TABLE IF EXISTS %s",
+      table_name);
+
+  return GetDB().Execute(sql.c_str());
+}
+
+bool BundleStateDatabase::ReplaceTable(
+    const char* table_name,
+    const char* staging_table_name) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!DropTable(table_name)) {
+    return false;
+  }
 
   const std::string sql = base::StringPrintf(
-      "INSERT OR REPLACE INTO ad_conversions "
-          "(creative_set_id, "
-          "type, "
-          "url_pattern, "
-          "observation_window) VALUES (%s)",
-      CreateBindingParameterPlaceholders(4).c_str());
-
-  sql::Statement statement(GetDB().GetUniqueStatement(sql.c_str()));
-
-  statement.BindString(0, info.creative_set_id);
-  statement.BindString(1, info.type);
-  statement.BindString(2, info.url_pattern);
-  // Use BindInt64 for uint32_t types to avoid uint32_t to int32_t cast.
-  statement.BindInt64(3, info.observation_window);
-
-  return statement.Run();
+      "ALTER TABLE %s RENAME TO %s",
+      staging_table_name, table_name);
+
+  return GetDB().Execute(sql.c_str());
 }
 
 bool BundleStateDatabase::SaveBundleState(
@@ -379,50 +395,85 @@ bool BundleStateDatabase::SaveBundleState(
   const bool is_initialized = Init();
   DCHECK(is_initialized);
 
-  if (!GetDB().BeginTransaction()) {
-    return false;
-  }
+  // Collect the rows up front, so that each table is filled by a few large
+  // statements instead of a statement per row
+  std::vector<std::string> categories;
+  categories.reserve(bundle_state.creative_ad_notifications.size());
 
-  // We are completely replacing the database here so truncate all the tables
-  if (!TruncateCategoriesTable() ||
-      !TruncateCreativeAdNotificationCategoriesTable() ||
-      !TruncateCreativeAdNotificationsTable() ||
-      !TruncateAdConversionsTable()) {
-    GetDB().RollbackTransaction();
-    return false;
+  size_t ad_count = 0;
+  for (const auto& creative_ad_notification :
+      bundle_state.creative_ad_notifications) {
+    ad_count += creative_ad_notification.second.size();
   }
 
+  std::vector<CreativeAdNotificationRow> ad_rows;
+  ad_rows.reserve(ad_count);
+  std::vector<CreativeAdNotificationCategoryRow> ad_category_rows;
+  ad_category_rows.reserve(ad_count);
+
   for (const auto& creative_ad_notification :
       bundle_state.creative_ad_notifications) {
-    const std::string category = creative_ad_notification.first;
-    if (!InsertOrUpdateCategory(category)) {
-      GetDB().RollbackTransaction();
-      return false;
-    }
+    const std::string& category = creative_ad_notification.first;
+    categories.push_back(category);
 
-    const ads::CreativeAdNotificationList ads = creative_ad_notification.second;
-    for (const auto& ad : ads) {
-      if (!InsertOrUpdateCreativeAdNotification(ad) ||
-          !InsertOrUpdateCreativeAdNotificationCategory(ad, category)) {
-        GetDB().RollbackTransaction();
-        return false;
+    for (const auto& ad : creative_ad_notification.second) {
+      for (const auto& geo_target : ad.geo_targets) {
+        ad_rows.push_back({&ad, &geo_target});
       }
+
+      ad_category_rows.push_back({&ad, &category});
     }
   }
 
-  for (const auto& ad_conversion : bundle_state.ad_conversions) {
-    if (!InsertOrUpdateAdConversion(ad_conversion)) {
-      GetDB().RollbackTransaction();
-      return false;
-    }
+  if (!GetDB().BeginTransaction()) {
+    return false;
   }
 
-  if (!GetDB().CommitTransaction()) {
+  // The new bundle is written to staging tables which have no index, then
+  // swapped in for the current tables. The staging tables could be left over
+  // from a save which did not complete
+  if (!DropTable(kCategoriesStagingTableName) ||
+      !DropTable(kCreativeAdNotificationsStagingTableName) ||
+      !DropTable(kCreativeAdNotificationCategoriesStagingTableName) ||
+      !DropTable(kAdConversionsStagingTableName) ||
+      !CreateCategoriesTable(kCategoriesStagingTableName) ||
+      !CreateCreativeAdNotificationsTable(
+          kCreativeAdNotificationsStagingTableName) ||
+      !CreateCreativeAdNotificationCategoriesTable(
+          kCreativeAdNotificationCategoriesStagingTableName) ||
+      !CreateAdConversionsTable(kAdConversionsStagingTableName)) {
+    GetDB().RollbackTransaction();
     return false;
   }
 
-  Vacuum();
-  return true;
+  if (!InsertCategories(kCategoriesStagingTableName, categories) ||
+      !InsertCreativeAdNotifications(
+          kCreativeAdNotificationsStagingTableName, ad_rows) ||
+      !InsertCreativeAdNotificationCategories(
+          kCreativeAdNotificationCategoriesStagingTableName,
+          ad_category_rows) ||
+      !InsertAdConversions(kAdConversionsStagingTableName,
+          bundle_state.ad_conversions)) {
+    GetDB().RollbackTransaction();
+    return false;
+  }
+
+  // Dropping ad_info_category also drops its index, which is built once over
+  // the new rows instead of being updated for every insert
+  if (!ReplaceTable(kCategoriesTableName, kCategoriesStagingTableName) ||
+      !ReplaceTable(kCreativeAdNotificationsTableName,
+          kCreativeAdNotificationsStagingTableName) ||
+      !ReplaceTable(kCreativeAdNotificationCategoriesTableName,
+          kCreativeAdNotificationCategoriesStagingTableName) ||
+      !ReplaceTable(kAdConversionsTableName, kAdConversionsStagingTableName) ||
+      !CreateCreativeAdNotificationCategoriesCategoryIndex()) {
+    GetDB().RollbackTransaction();
+    return false;
+  }
+
+  // The pages freed by the old tables are reused by the next save, so there
+  // is no need to vacuum
+  return GetDB().CommitTransaction();
 }
 
 bool BundleStateDatabase::GetCreativeAdNotifications(
@@ -65,28 +65,60 @@ class BundleStateDatabase {
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
-  bool CreateCategoriesTable();
-  bool TruncateCategoriesTable();
-  bool InsertOrUpdateCategory(
-      const std::string& category);
-
-  bool CreateCreativeAdNotificationsTable();
-  bool TruncateCreativeAdNotificationsTable();
-  bool InsertOrUpdateCreativeAdNotification(
-      const ads::CreativeAdNotificationInfo& info);
-
-  bool CreateCreativeAdNotificationCategoriesTable();
-  bool TruncateCreativeAdNotificationCategoriesTable();
-  bool InsertOrUpdateCreativeAdNotificationCategory(
-      const ads::CreativeAdNotificationInfo& info,
-      const std::string& category);
+  struct CreativeAdNotificationRow {
+    const ads::CreativeAdNotificationInfo* info;
+    const std::string* geo_target;
+  };
+
+  struct CreativeAdNotificationCategoryRow {
+    const ads::CreativeAdNotificationInfo* info;
+    const std::string* category;
+  };
+
+  bool CreateCategoriesTable(
+      const char* table_name);
+  bool InsertCategories(
+      const char* table_name,
+      const std::vector<std::string>& categories);
+
+  bool CreateCreativeAdNotificationsTable(
+      const char* table_name);
+  bool InsertCreativeAdNotifications(
+      const char* table_name,
+      const std::vector<CreativeAdNotificationRow>& rows);
+
+  bool CreateCreativeAdNotificationCategoriesTable(
+      const char* table_name);
+  bool InsertCreativeAdNotificationCategories(
+      const char* table_name,
+      const std::vector<CreativeAdNotificationCategoryRow>& rows);
 
   bool CreateCreativeAdNotificationCategoriesCategoryIndex();
 
-  bool CreateAdConversionsTable();
-  bool TruncateAdConversionsTable();
-  bool InsertOrUpdateAdConversion(
-      const ads::AdConversionInfo& info);
+  bool CreateAdConversionsTable(
+      const char* table_name);
+  bool InsertAdConversions(
+      const char* table_name,
+      const ads::AdConversionList& ad_conversions);
+
+  // Inserts |rows| into |table_name| using as few statements as SQLite allows.
+  // |bind_row| binds the |column_count| values of a row starting at the given
+  // parameter index
+  template <typename Row, typename BindRow>
+  bool InsertRows(
+      const char* table_name,
+      const char* columns,
+      const size_t column_count,
+      const std::vector<Row>& rows,
+      BindRow bind_row);
+
+  bool DropTable(
+      const char* table_name);
+  // Replaces |table_name| with |staging_table_name|, dropping the indexes of
+  // |table_name|
+  bool ReplaceTable(
+      const char* table_name,
+      const char* staging_table_name);
 
   std::string CreateBindingParameterPlaceholders(
       const size_t count);
@@ -0,0 +1,132 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BundleStateDatabaseTest.*
+
+namespace brave_ads {
+
+namespace {
+
+// Builds a catalog of |creative_count| creatives spread over |category_count|
+// categories, each targeting two regions
+ads::BundleState BuildBundleState(
+    const size_t category_count,
+    const size_t creative_count) {
+  ads::BundleState bundle_state;
+
+  for (size_t i = 0; i < creative_count; i++) {
+    const std::string category =
+        "category-" + base::NumberToString(i % category_count);
+
+    ads::CreativeAdNotificationInfo info;
+    info.creative_instance_id = "creative-" + base::NumberToString(i);
+    info.creative_set_id = "creative-set-" + base::NumberToString(i / 10);
+    info.campaign_id = "campaign-" + base::NumberToString(i / 100);
+    info.start_at_timestamp = "2000-01-01 00:00";
+    info.end_at_timestamp = "2099-12-31 23:59";
+    info.daily_cap = 1;
+    info.advertiser_id = "advertiser";
+    info.per_day = 2;
+    info.total_max = 3;
+    info.geo_targets = {"US", "CA"};
+    info.target_url = "https://brave.com/";
+    info.title = "Title";
+    info.body = "Body";
+
+    bundle_state.creative_ad_notifications[category].push_back(info);
+  }
+
+  ads::AdConversionInfo ad_conversion;
+  ad_conversion.creative_set_id = "creative-set-0";
+  ad_conversion.type = "postview";
+  ad_conversion.url_pattern = "https://brave.com/*";
+  ad_conversion.observation_window = 30;
+  bundle_state.ad_conversions.push_back(ad_conversion);
+
+  return bundle_state;
+}
+
+}  // namespace
+
+class BundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  BundleStateDatabaseTest() {}
+
+  ~BundleStateDatabaseTest() override {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<BundleStateDatabase>(
+        temp_dir_.GetPath().AppendASCII("bundle_state"));
+  }
+
+  size_t CountCreativeAdNotifications(
+      const std::vector<std::string>& categories) {
+    ads::CreativeAdNotificationList ads;
+    EXPECT_TRUE(database_->GetCreativeAdNotifications(categories, &ads));
+    return ads.size();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BundleStateDatabase> database_;
+};
+
+TEST_F(BundleStateDatabaseTest, SaveBundleState) {
+  EXPECT_TRUE(database_->SaveBundleState(BuildBundleState(10, 100)));
+
+  // Each creative is listed once per region
+  EXPECT_EQ(20u, CountCreativeAdNotifications({"category-0"}));
+  EXPECT_EQ(40u, CountCreativeAdNotifications({"category-0", "category-1"}));
+  EXPECT_EQ(0u, CountCreativeAdNotifications({"category-10"}));
+
+  ads::AdConversionList ad_conversions;
+  EXPECT_TRUE(database_->GetAdConversions(&ad_conversions));
+  ASSERT_EQ(1u, ad_conversions.size());
+  EXPECT_EQ("creative-set-0", ad_conversions[0].creative_set_id);
+  EXPECT_EQ(30u, ad_conversions[0].observation_window);
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleStateReplacesPreviousBundle) {
+  EXPECT_TRUE(database_->SaveBundleState(BuildBundleState(10, 100)));
+  EXPECT_TRUE(database_->SaveBundleState(BuildBundleState(5, 10)));
+
+  EXPECT_EQ(4u, CountCreativeAdNotifications({"category-0"}));
+  EXPECT_EQ(0u, CountCreativeAdNotifications({"category-5"}));
+
+  ads::AdConversionList ad_conversions;
+  EXPECT_TRUE(database_->GetAdConversions(&ad_conversions));
+  EXPECT_EQ(1u, ad_conversions.size());
+
+  EXPECT_TRUE(database_->SaveBundleState(ads::BundleState()));
+  EXPECT_EQ(0u, CountCreativeAdNotifications({"category-0"}));
+}
+
+// Saves a catalog with 10000 creatives, which takes several statements per
+// table, and then saves it again over itself
+TEST_F(BundleStateDatabaseTest, SaveLargeBundleState) {
+  const ads::BundleState bundle_state = BuildBundleState(50, 10000);
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_TRUE(database_->SaveBundleState(bundle_state));
+
+    EXPECT_EQ(400u, CountCreativeAdNotifications({"category-0"}));
+    EXPECT_EQ(800u, CountCreativeAdNotifications({"category-0",
+        "category-49"}));
+  }
+}
+
+}  // namespace brave_ads
@@ -9,6 +9,11 @@ if (chrome.braveShields) {
   chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
     actions.resourceBlocked(detail)
   })
+  chrome.braveShields.onBlockedBatch.addListener((details: BlockDetails[]) => {
+    details.forEach((detail: BlockDetails) => {
+      actions.resourceBlocked(detail)
+    })
+  })
 } else {
   console.log('chrome.braveShields not enabled')
 }
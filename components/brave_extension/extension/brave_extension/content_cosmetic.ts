@@ -3,6 +3,8 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this file,
 // you can obtain one at http://mozilla.org/MPL/2.0/.
 
+import { taskize } from './helpers/taskUtils'
+
 // Notify the background script as soon as the content script has loaded.
 // chrome.tabs.insertCSS may sometimes fail to inject CSS in a newly navigated
 // page when using the chrome.webNavigation API.
@@ -94,6 +96,11 @@ const fetchNewClassIdRules = function () {
   notYetQueriedIds = []
 }
 
+// Mutation observer callbacks can fire many times in a row on pages which
+// keep adding content, such as infinite feeds. Collect the new classes and ids
+// from all of them and ask the background script about them in one message.
+const fetchNewClassIdRulesOnTask = taskize(fetchNewClassIdRules)
+
 const handleMutations: MutationCallback = function (mutations: MutationRecord[]) {
   for (const aMutation of mutations) {
     if (aMutation.type === 'attributes') {
@@ -142,7 +149,7 @@ const handleMutations: MutationCallback = function (mutations: MutationRecord[])
     }
   }
 
-  fetchNewClassIdRules()
+  fetchNewClassIdRulesOnTask()
 }
 
 const _parseDomainCache = Object.create(null)
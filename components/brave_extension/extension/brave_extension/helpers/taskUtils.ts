@@ -0,0 +1,25 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+ * Provides a new function which can only be scheduled once at a time, so that
+ * work requested several times before the next task is done once.
+ *
+ * Unlike requestAnimationFrame, timers keep running in hidden tabs
+ * (throttled, not paused), so the work is never stalled there.
+ *
+ * @param onTask function to run in a later task
+ */
+export const taskize = (onTask: Function) => {
+  let timeoutId: number | undefined = undefined
+  return function WillRunOnTask () {
+    if (timeoutId !== undefined) {
+      return
+    }
+    timeoutId = window.setTimeout(() => {
+      timeoutId = undefined
+      onTask()
+    }, 0)
+  }
+}
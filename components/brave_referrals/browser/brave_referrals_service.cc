@@ -22,6 +22,7 @@
 #include "base/values.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "brave_base/random.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/first_run/first_run.h"
@@ -35,7 +36,6 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/page_navigator.h"
 #include "content/public/common/referrer.h"
-#include "extensions/common/url_pattern.h"
 #include "net/base/load_flags.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -165,41 +165,6 @@ void BraveReferralsService::Stop() {
   initialized_ = false;
 }
 
-// static
-bool BraveReferralsService::GetMatchingReferralHeaders(
-    const base::ListValue& referral_headers_list,
-    const base::DictionaryValue** request_headers_dict,
-    const GURL& url) {
-  // If the domain for this request matches one of our target domains,
-  // set the associated custom headers.
-  for (const auto& headers_value : referral_headers_list) {
-    const base::Value* domains_list =
-        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
-    if (!domains_list) {
-      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
-      continue;
-    }
-    const base::Value* headers_dict =
-        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
-    if (!headers_dict) {
-      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
-      continue;
-    }
-    for (const auto& domain_value : domains_list->GetList()) {
-      URLPattern url_pattern(URLPattern::SCHEME_HTTPS |
-                             URLPattern::SCHEME_HTTP);
-      url_pattern.SetScheme("*");
-      url_pattern.SetHost(domain_value.GetString());
-      url_pattern.SetPath("/*");
-      url_pattern.SetMatchSubdomains(true);
-      if (!url_pattern.MatchesURL(url))
-        continue;
-      return headers_dict->GetAsDictionary(request_headers_dict);
-    }
-  }
-  return false;
-}
-
 void BraveReferralsService::OnFinalizationChecksTimerFired() {
   PerformFinalizationChecks();
 }
@@ -646,9 +611,11 @@ std::string BraveReferralsService::FormatExtraHeaders(
   if (!referral_headers->GetAsList(&referral_headers_list))
     return std::string();
 
+  const brave::ReferralHeadersMatcher referral_headers_matcher(
+      *referral_headers_list);
   const base::DictionaryValue* request_headers_dict = nullptr;
-  if (!GetMatchingReferralHeaders(*referral_headers_list, &request_headers_dict,
-                                  url))
+  if (!referral_headers_matcher.GetMatchingReferralHeaders(
+          &request_headers_dict, url))
     return std::string();
 
   std::string extra_headers;
@@ -36,11 +36,6 @@ class BraveReferralsService {
   void Start();
   void Stop();
 
-  static bool GetMatchingReferralHeaders(
-      const base::ListValue& referral_headers_list,
-      const base::DictionaryValue** request_headers_dict,
-      const GURL& url);
-
  private:
   void GetFirstRunTime();
   void GetFirstRunTimeDesktop();
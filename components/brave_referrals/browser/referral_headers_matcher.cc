@@ -0,0 +1,56 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include "base/logging.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+ReferralHeadersMatcher::ReferralHeadersMatcher(
+    const base::ListValue& referral_headers_list)
+    : referral_headers_list_(referral_headers_list.Clone().TakeList()) {
+  for (const auto& headers_value : referral_headers_list_.GetList()) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+    for (const auto& domain_value : domains_list->GetList()) {
+      URLPattern url_pattern(URLPattern::SCHEME_HTTPS |
+                             URLPattern::SCHEME_HTTP);
+      url_pattern.SetScheme("*");
+      url_pattern.SetHost(domain_value.GetString());
+      url_pattern.SetPath("/*");
+      url_pattern.SetMatchSubdomains(true);
+      domains_.Add(url_pattern);
+      headers_.push_back(headers_dict);
+    }
+  }
+}
+
+ReferralHeadersMatcher::~ReferralHeadersMatcher() = default;
+
+bool ReferralHeadersMatcher::GetMatchingReferralHeaders(
+    const base::DictionaryValue** request_headers_dict,
+    const GURL& url) const {
+  const size_t position = domains_.FindFirstMatch(url);
+  if (position == URLPatternHostIndex::kNoMatch) {
+    return false;
+  }
+
+  return headers_[position]->GetAsDictionary(request_headers_dict);
+}
+
+}  // namespace brave
@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/values.h"
+#include "brave/common/url_pattern_host_index.h"
+
+class GURL;
+
+namespace brave {
+
+// Compiles the domains of a referral headers list into a host index once, so
+// that matching a request does not build a URLPattern for every domain.
+class ReferralHeadersMatcher {
+ public:
+  explicit ReferralHeadersMatcher(const base::ListValue& referral_headers_list);
+  ~ReferralHeadersMatcher();
+
+  // Sets |request_headers_dict| to the headers of the first entry with a
+  // domain matching |url|, in list order. Returns false if none matches.
+  bool GetMatchingReferralHeaders(
+      const base::DictionaryValue** request_headers_dict,
+      const GURL& url) const;
+
+ private:
+  base::ListValue referral_headers_list_;
+
+  // Headers for each pattern in |domains_|, indexed by pattern position.
+  std::vector<const base::Value*> headers_;
+  URLPatternHostIndex domains_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferralHeadersMatcher);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
@@ -17,7 +17,6 @@
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
 #include "base/files/file_util.h"
-#include "base/files/important_file_writer.h"
 #include "base/i18n/time_formatting.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
@@ -30,7 +29,6 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
-#include "base/threading/sequenced_task_runner_handle.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/mojom_structs.h"
@@ -218,18 +216,6 @@ std::pair<std::string, base::Value> LoadStateOnFileTaskRunner(
   return result;
 }
 
-// `callback` has a WeakPtr so this won't crash if the file finishes
-// writing after RewardsServiceImpl has been destroyed
-void PostWriteCallback(
-    const base::Callback<void(bool success)>& callback,
-    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
-    bool write_success) {
-  // We can't run |callback| on the current thread. Bounce back to
-  // the |reply_task_runner| which is the correct sequenced thread.
-  reply_task_runner->PostTask(FROM_HERE,
-                              base::Bind(callback, write_success));
-}
-
 time_t GetCurrentTimestamp() {
   return base::Time::NowFromSystemTime().ToTimeT();
 }
@@ -316,6 +302,11 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTagForURLLoad() {
 
 const char pref_prefix[] = "brave.rewards.";
 
+// State is saved after nearly every change, so writes are coalesced over this
+// interval
+constexpr base::TimeDelta kStateFileCommitInterval =
+    base::TimeDelta::FromSeconds(1);
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -758,6 +749,10 @@ void RewardsServiceImpl::Shutdown() {
   }
   url_loaders_.clear();
 
+  for (auto& writer : state_file_writers_) {
+    writer.second->CommitPendingWrite();
+  }
+
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
@@ -902,6 +897,7 @@ void RewardsServiceImpl::OnReconcileComplete(
 
 void RewardsServiceImpl::LoadLedgerState(
     ledger::OnLoadCallback callback) {
+  CommitPendingStateFileWrite(ledger_state_path_);
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadStateOnFileTaskRunner, ledger_state_path_),
       base::BindOnce(&RewardsServiceImpl::OnLedgerStateLoaded,
@@ -947,6 +943,7 @@ void RewardsServiceImpl::LoadPublisherState(
         base::BindOnce(&RewardsServiceImpl::SetRewardsMainEnabledPref,
           AsWeakPtr()));
   }
+  CommitPendingStateFileWrite(publisher_state_path_);
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadOnFileTaskRunner, publisher_state_path_),
       base::BindOnce(&RewardsServiceImpl::OnPublisherStateLoaded,
@@ -972,19 +969,11 @@ void RewardsServiceImpl::SaveLedgerState(
   if (reset_states_) {
     return;
   }
-  base::ImportantFileWriter writer(
-      ledger_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnLedgerStateSaved,
-            AsWeakPtr(),
-            callback),
-        base::SequencedTaskRunnerHandle::Get()));
-
-  writer.WriteNow(std::make_unique<std::string>(ledger_state));
+  GetStateFileWriter(ledger_state_path_)->Save(
+      ledger_state,
+      base::BindOnce(&RewardsServiceImpl::OnLedgerStateSaved,
+          AsWeakPtr(),
+          callback));
 }
 
 void RewardsServiceImpl::OnLedgerStateSaved(
@@ -1005,19 +994,11 @@ void RewardsServiceImpl::SavePublisherState(
   if (reset_states_) {
     return;
   }
-  base::ImportantFileWriter writer(publisher_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(
-            &RewardsServiceImpl::OnPublisherStateSaved,
-            AsWeakPtr(),
-            callback),
-        base::SequencedTaskRunnerHandle::Get()));
-
-  writer.WriteNow(std::make_unique<std::string>(publisher_state));
+  GetStateFileWriter(publisher_state_path_)->Save(
+      publisher_state,
+      base::BindOnce(&RewardsServiceImpl::OnPublisherStateSaved,
+          AsWeakPtr(),
+          callback));
 }
 
 void RewardsServiceImpl::OnPublisherStateSaved(
@@ -1031,6 +1012,33 @@ void RewardsServiceImpl::OnPublisherStateSaved(
       : ledger::Result::LEDGER_ERROR);
 }
 
+StateFileWriter* RewardsServiceImpl::GetStateFileWriter(
+    const base::FilePath& path) {
+  auto& writer = state_file_writers_[path];
+  if (!writer) {
+    writer = std::make_unique<StateFileWriter>(path, file_task_runner_,
+        kStateFileCommitInterval);
+  }
+
+  return writer.get();
+}
+
+void RewardsServiceImpl::CommitPendingStateFileWrite(
+    const base::FilePath& path) {
+  auto it = state_file_writers_.find(path);
+  if (it != state_file_writers_.end()) {
+    it->second->CommitPendingWrite();
+  }
+}
+
+void RewardsServiceImpl::CancelPendingStateFileWrite(
+    const base::FilePath& path) {
+  auto it = state_file_writers_.find(path);
+  if (it != state_file_writers_.end()) {
+    it->second->CancelPendingWrite();
+  }
+}
+
 void RewardsServiceImpl::LoadNicewareList(
   ledger::GetNicewareListCallback callback) {
   if (!Connected())
@@ -1535,23 +1543,17 @@ void RewardsServiceImpl::SaveState(const std::string& name,
   if (reset_states_) {
     return;
   }
-  base::ImportantFileWriter writer(
-      rewards_base_path_.AppendASCII(name), file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(&PostWriteCallback,
-                 base::Bind(&RewardsServiceImpl::OnSavedState,
-                            AsWeakPtr(),
-                            std::move(callback)),
-                 base::SequencedTaskRunnerHandle::Get()));
-
-  writer.WriteNow(std::make_unique<std::string>(value));
+  GetStateFileWriter(rewards_base_path_.AppendASCII(name))->Save(
+      value,
+      base::BindOnce(&RewardsServiceImpl::OnSavedState,
+          AsWeakPtr(),
+          std::move(callback)));
 }
 
 void RewardsServiceImpl::LoadState(
     const std::string& name,
     ledger::OnLoadCallback callback) {
+  CommitPendingStateFileWrite(rewards_base_path_.AppendASCII(name));
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadOnFileTaskRunner,
@@ -1563,6 +1565,7 @@ void RewardsServiceImpl::LoadState(
 void RewardsServiceImpl::ResetState(
     const std::string& name,
     ledger::ResultCallback callback) {
+  CancelPendingStateFileWrite(rewards_base_path_.AppendASCII(name));
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ResetOnFileTaskRunner,
@@ -1574,6 +1577,9 @@ void RewardsServiceImpl::ResetState(
 void RewardsServiceImpl::ResetTheWholeState(
     const base::Callback<void(bool)>& callback) {
   reset_states_ = true;
+  for (auto& writer : state_file_writers_) {
+    writer.second->CancelPendingWrite();
+  }
   notification_service_->DeleteAllNotifications();
   std::vector<base::FilePath> paths;
   paths.push_back(ledger_state_path_);
@@ -32,6 +32,7 @@
 #include "ui/gfx/image/image.h"
 #include "brave/components/brave_rewards/browser/publisher_banner.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
+#include "brave/components/brave_rewards/browser/state_file_writer.h"
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 #include "brave/components/brave_rewards/browser/extension_rewards_service_observer.h"
@@ -327,6 +328,9 @@ class RewardsServiceImpl : public RewardsService,
       bool success);
   void OnPublisherStateLoaded(ledger::OnLoadCallback callback,
                               const std::string& data);
+  StateFileWriter* GetStateFileWriter(const base::FilePath& path);
+  void CommitPendingStateFileWrite(const base::FilePath& path);
+  void CancelPendingStateFileWrite(const base::FilePath& path);
   void OnFetchWalletProperties(const ledger::Result result,
                                ledger::WalletPropertiesPtr properties);
   void OnFetchPromotions(
@@ -693,6 +697,8 @@ class RewardsServiceImpl : public RewardsService,
   const base::FilePath publisher_info_db_path_;
   const base::FilePath publisher_list_path_;
   const base::FilePath rewards_base_path_;
+  std::map<base::FilePath, std::unique_ptr<StateFileWriter>>
+      state_file_writers_;
   std::unique_ptr<RewardsDatabase> rewards_database_;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
   base::ObserverList<RewardsServicePrivateObserver> private_observers_;
@@ -0,0 +1,114 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/state_file_writer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/sequenced_task_runner.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
+namespace brave_rewards {
+
+namespace {
+
+void PostWriteCallback(
+    base::OnceCallback<void(bool success)> callback,
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+    bool write_success) {
+  // |ImportantFileWriter| runs this on the file task runner, so bounce back
+  // to the sequence that saved the data.
+  reply_task_runner->PostTask(FROM_HERE,
+      base::BindOnce(std::move(callback), write_success));
+}
+
+void RunSaveCallbacks(
+    std::vector<StateFileWriter::SaveCallback> callbacks,
+    bool success) {
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(success);
+  }
+}
+
+}  // namespace
+
+StateFileWriter::StateFileWriter(
+    const base::FilePath& path,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    base::TimeDelta commit_interval)
+    : writer_(path, std::move(file_task_runner), commit_interval) {
+}
+
+StateFileWriter::~StateFileWriter() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CommitPendingWrite();
+}
+
+void StateFileWriter::Save(const std::string& data, SaveCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  pending_data_ = data;
+  is_cancelled_ = false;
+  if (callback) {
+    pending_callbacks_.push_back(std::move(callback));
+  }
+
+  writer_.ScheduleWrite(this);
+}
+
+void StateFileWriter::CommitPendingWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (writer_.HasPendingWrite()) {
+    writer_.DoScheduledWrite();
+  }
+}
+
+void StateFileWriter::CancelPendingWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  pending_data_.clear();
+  is_cancelled_ = true;
+
+  if (pending_callbacks_.empty()) {
+    return;
+  }
+
+  // Posted, like the callbacks of a write, so that callers are not
+  // re-entered while they cancel
+  base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+      base::BindOnce(&RunSaveCallbacks, std::move(pending_callbacks_), false));
+  pending_callbacks_.clear();
+}
+
+bool StateFileWriter::HasPendingWrite() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return !is_cancelled_ && writer_.HasPendingWrite();
+}
+
+bool StateFileWriter::SerializeData(std::string* data) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (is_cancelled_) {
+    return false;
+  }
+
+  // Registered here, rather than in |Save|, so that every save since the last
+  // write is answered by the write that includes its data.
+  writer_.RegisterOnNextWriteCallbacks(
+      base::OnceClosure(),
+      base::BindOnce(&PostWriteCallback,
+          base::BindOnce(&RunSaveCallbacks, std::move(pending_callbacks_)),
+          base::SequencedTaskRunnerHandle::Get()));
+  pending_callbacks_.clear();
+
+  data->swap(pending_data_);
+  pending_data_.clear();
+  return true;
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_STATE_FILE_WRITER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_STATE_FILE_WRITER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace brave_rewards {
+
+// Coalesces writes of a state file which is saved after nearly every change.
+// Each save replaces the data waiting to be written, so a burst of saves
+// writes the file once with the latest data instead of once per save.
+class StateFileWriter : public base::ImportantFileWriter::DataSerializer {
+ public:
+  using SaveCallback = base::OnceCallback<void(bool success)>;
+
+  StateFileWriter(
+      const base::FilePath& path,
+      scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+      base::TimeDelta commit_interval);
+  ~StateFileWriter() override;
+
+  // Schedules |data| to be written. |callback| is run on the calling sequence
+  // once the write that includes |data|, or later data, has finished.
+  void Save(const std::string& data, SaveCallback callback);
+
+  // Writes any pending data now. Tasks posted to the file task runner after
+  // this is called see the new file contents.
+  void CommitPendingWrite();
+
+  // Drops any pending data without writing it, e.g. before the file is
+  // deleted. Callbacks waiting for that data are run with false.
+  void CancelPendingWrite();
+
+  bool HasPendingWrite() const;
+
+  const base::FilePath& path() const { return writer_.path(); }
+
+ private:
+  // base::ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
+  base::ImportantFileWriter writer_;
+  std::string pending_data_;
+  bool is_cancelled_ = false;
+  std::vector<SaveCallback> pending_callbacks_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(StateFileWriter);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_STATE_FILE_WRITER_H_
@@ -0,0 +1,147 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/state_file_writer.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/task/post_task.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=StateFileWriterTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+const base::TimeDelta kCommitInterval = base::TimeDelta::FromSeconds(1);
+
+}  // namespace
+
+class StateFileWriterTest : public testing::Test {
+ public:
+  StateFileWriterTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+  }
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("state");
+    writer_ = std::make_unique<StateFileWriter>(path_,
+        base::CreateSequencedTaskRunner(
+            {base::ThreadPool(), base::MayBlock()}),
+        kCommitInterval);
+  }
+
+ protected:
+  StateFileWriter::SaveCallback SaveCallback(int* count, bool* success) {
+    return base::BindOnce([](int* count, bool* success, bool result) {
+      (*count)++;
+      *success = result;
+    }, count, success);
+  }
+
+  std::string ReadState() {
+    std::string data;
+    base::ReadFileToString(path_, &data);
+    return data;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  std::unique_ptr<StateFileWriter> writer_;
+};
+
+TEST_F(StateFileWriterTest, CoalescesSaves) {
+  int first_count = 0;
+  bool first_success = false;
+  int second_count = 0;
+  bool second_success = false;
+
+  writer_->Save("first", SaveCallback(&first_count, &first_success));
+  writer_->Save("second", SaveCallback(&second_count, &second_success));
+  EXPECT_TRUE(writer_->HasPendingWrite());
+
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_EQ(0, first_count);
+
+  task_environment_.FastForwardBy(kCommitInterval);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(writer_->HasPendingWrite());
+  EXPECT_EQ("second", ReadState());
+  EXPECT_EQ(1, first_count);
+  EXPECT_TRUE(first_success);
+  EXPECT_EQ(1, second_count);
+  EXPECT_TRUE(second_success);
+}
+
+TEST_F(StateFileWriterTest, CommitPendingWrite) {
+  int count = 0;
+  bool success = false;
+
+  writer_->Save("state", SaveCallback(&count, &success));
+  writer_->CommitPendingWrite();
+  EXPECT_FALSE(writer_->HasPendingWrite());
+
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ("state", ReadState());
+  EXPECT_EQ(1, count);
+  EXPECT_TRUE(success);
+}
+
+TEST_F(StateFileWriterTest, CancelPendingWrite) {
+  int first_count = 0;
+  bool first_success = true;
+  int second_count = 0;
+  bool second_success = true;
+
+  writer_->Save("first", SaveCallback(&first_count, &first_success));
+  writer_->Save("second", SaveCallback(&second_count, &second_success));
+  writer_->CancelPendingWrite();
+  EXPECT_FALSE(writer_->HasPendingWrite());
+  // The dropped saves are answered asynchronously
+  EXPECT_EQ(0, first_count);
+
+  task_environment_.FastForwardBy(kCommitInterval);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_EQ(1, first_count);
+  EXPECT_FALSE(first_success);
+  EXPECT_EQ(1, second_count);
+  EXPECT_FALSE(second_success);
+
+  // A save after the cancel is written as usual
+  int count = 0;
+  bool success = false;
+  writer_->Save("state", SaveCallback(&count, &success));
+  writer_->CommitPendingWrite();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ("state", ReadState());
+  EXPECT_EQ(1, count);
+  EXPECT_TRUE(success);
+  EXPECT_EQ(1, first_count);
+}
+
+TEST_F(StateFileWriterTest, WritesPendingDataWhenDestroyed) {
+  writer_->Save("state", StateFileWriter::SaveCallback());
+  writer_.reset();
+
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ("state", ReadState());
+}
+
+}  // namespace brave_rewards
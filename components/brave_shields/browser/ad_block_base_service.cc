@@ -34,6 +34,8 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+const size_t kCosmeticResourcesCacheSize = 100;
+
 std::string ResourceTypeToString(content::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -107,6 +109,7 @@ namespace brave_shields {
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new adblock::Engine()),
+      cosmetic_resources_cache_(kCosmeticResourcesCacheSize),
       weak_factory_(this) {}
 
 AdBlockBaseService::~AdBlockBaseService() {
@@ -167,6 +170,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  ClearCosmeticResourcesCache();
   if (enabled) {
     ad_block_client_->addTag(tag);
     tags_.push_back(tag);
@@ -180,16 +184,19 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
   }
 }
 
-void AdBlockBaseService::AddResources(const std::string& resources) {
+void AdBlockBaseService::AddResources(
+    scoped_refptr<base::RefCountedString> resources) {
   if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
     GetTaskRunner()->PostTask(
         FROM_HERE, base::BindOnce(&AdBlockBaseService::AddResources,
-                                  base::Unretained(this), resources));
+                                  base::Unretained(this),
+                                  std::move(resources)));
     return;
   }
 
-  ad_block_client_->addResources(resources);
-  resources_ = resources;
+  resources_ = std::move(resources);
+  AddKnownResourcesToAdBlockInstance();
+  ClearCosmeticResourcesCache();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -198,14 +205,27 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
 
 base::Optional<base::Value> AdBlockBaseService::HostnameCosmeticResources(
         const std::string& hostname) {
-  return base::JSONReader::Read(
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+
+  auto it = cosmetic_resources_cache_.Get(hostname);
+  if (it != cosmetic_resources_cache_.end()) {
+    return it->second.Clone();
+  }
+
+  base::Optional<base::Value> resources = base::JSONReader::Read(
           this->ad_block_client_->hostnameCosmeticResources(hostname));
+  if (resources) {
+    cosmetic_resources_cache_.Put(hostname, resources->Clone());
+  }
+
+  return resources;
 }
 
 base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
   return base::JSONReader::Read(
           this->ad_block_client_->hiddenClassIdSelectors(classes,
                                                          ids,
@@ -242,6 +262,7 @@ void AdBlockBaseService::UpdateAdBlockClient(
   ad_block_client_ = std::move(ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  ClearCosmeticResourcesCache();
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -250,7 +271,9 @@ void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
 }
 
 void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+  if (resources_) {
+    ad_block_client_->addResources(resources_->data());
+  }
 }
 
 bool AdBlockBaseService::Init() {
@@ -265,9 +288,15 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   ad_block_client_.reset(new adblock::Engine(rules));
   AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
-    resources_ = resources;
+    std::string resources_copy = resources;
+    resources_ = base::RefCountedString::TakeString(&resources_copy);
   }
   AddKnownResourcesToAdBlockInstance();
+  ClearCosmeticResourcesCache();
+}
+
+void AdBlockBaseService::ClearCosmeticResourcesCache() {
+  cosmetic_resources_cache_.Clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
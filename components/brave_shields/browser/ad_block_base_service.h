@@ -13,7 +13,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/values.h"
@@ -43,10 +46,14 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   bool ShouldStartRequest(const GURL &url, content::ResourceType resource_type,
     const std::string& tab_host, bool* did_match_exception,
     bool* cancel_request_explicitly, std::string* mock_data_url) override;
-  void AddResources(const std::string& resources);
+  // |resources| is shared by every ad-block service rather than copied into
+  // each of them.
+  void AddResources(scoped_refptr<base::RefCountedString> resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  // Must be called on the task runner, since that is where
+  // |ad_block_client_| is used and replaced.
   base::Optional<base::Value> HostnameCosmeticResources(
           const std::string& hostname);
   base::Optional<base::Value> HiddenClassIdSelectors(
@@ -63,6 +70,9 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void AddKnownTagsToAdBlockInstance();
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules, const std::string& resources);
+  // Must be called whenever |ad_block_client_|, its tags or its resources
+  // change.
+  void ClearCosmeticResourcesCache();
 
   std::unique_ptr<adblock::Engine> ad_block_client_;
 
@@ -73,7 +83,10 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::vector<std::string> tags_;
-  std::string resources_;
+  scoped_refptr<base::RefCountedString> resources_;
+  // Parsed results of |HostnameCosmeticResources| for recently visited
+  // hostnames, so that every frame of a page does not parse them again.
+  base::MRUCache<std::string, base::Value> cosmetic_resources_cache_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -154,10 +154,11 @@ void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
 }
 
 void AdBlockRegionalServiceManager::AddResources(
-    const std::string& resources) {
+    scoped_refptr<base::RefCountedString> resources) {
   base::AutoLock lock(regional_services_lock_);
+  resources_ = std::move(resources);
   for (const auto& regional_service : regional_services_) {
-    regional_service.second->AddResources(resources);
+    regional_service.second->AddResources(resources_);
   }
 }
 
@@ -173,6 +174,9 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
       DCHECK(it == regional_services_.end());
       auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
       regional_service->Start();
+      if (resources_) {
+        regional_service->AddResources(resources_);
+      }
       regional_services_.insert(
           std::make_pair(uuid, std::move(regional_service)));
     } else {
@@ -194,6 +198,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
 base::Optional<base::Value>
 AdBlockRegionalServiceManager::HostnameCosmeticResources(
         const std::string& hostname) {
+  base::AutoLock lock(regional_services_lock_);
   auto it = this->regional_services_.begin();
   if (it == this->regional_services_.end()) {
     return base::Optional<base::Value>();
@@ -201,7 +206,7 @@ AdBlockRegionalServiceManager::HostnameCosmeticResources(
   base::Optional<base::Value> first_value =
       it->second->HostnameCosmeticResources(hostname);
 
-  for ( ; it != this->regional_services_.end(); it++) {
+  for (it++; it != this->regional_services_.end(); it++) {
     base::Optional<base::Value> next_value =
         it->second->HostnameCosmeticResources(hostname);
     if (first_value) {
@@ -221,6 +226,7 @@ AdBlockRegionalServiceManager::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
+  base::AutoLock lock(regional_services_lock_);
   auto it = this->regional_services_.begin();
   if (it == this->regional_services_.end()) {
     return base::Optional<base::Value>();
@@ -228,7 +234,7 @@ AdBlockRegionalServiceManager::HiddenClassIdSelectors(
   base::Optional<base::Value> first_value =
       it->second->HiddenClassIdSelectors(classes, ids, exceptions);
 
-  for ( ; it != this->regional_services_.end(); it++) {
+  for (it++; it != this->regional_services_.end(); it++) {
     base::Optional<base::Value> next_value =
         it->second->HiddenClassIdSelectors(classes, ids, exceptions);
     if (first_value && first_value->is_list()) {
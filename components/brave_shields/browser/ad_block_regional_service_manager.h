@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/optional.h"
 #include "base/synchronization/lock.h"
@@ -52,7 +53,7 @@ class AdBlockRegionalServiceManager {
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url);
   void EnableTag(const std::string& tag, bool enabled);
-  void AddResources(const std::string& resources);
+  void AddResources(scoped_refptr<base::RefCountedString> resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
 
   base::Optional<base::Value> HostnameCosmeticResources(
@@ -73,6 +74,9 @@ class AdBlockRegionalServiceManager {
   base::Lock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
+  // Handed to regional services which are enabled after the resources have
+  // been loaded.
+  scoped_refptr<base::RefCountedString> resources_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalServiceManager);
 };
@@ -13,6 +13,7 @@
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
@@ -83,12 +84,15 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdBlockService::OnResourcesFileDataReady(const std::string& resources) {
-  g_brave_browser_process->ad_block_service()->AddResources(resources);
+void AdBlockService::OnResourcesFileDataReady(std::string resources) {
+  // All engines share the one copy of the resources.
+  scoped_refptr<base::RefCountedString> shared_resources =
+      base::RefCountedString::TakeString(&resources);
+  g_brave_browser_process->ad_block_service()->AddResources(shared_resources);
   g_brave_browser_process->ad_block_regional_service_manager()->AddResources(
-      resources);
+      shared_resources);
   g_brave_browser_process->ad_block_custom_filters_service()->AddResources(
-      resources);
+      shared_resources);
 }
 
 // static
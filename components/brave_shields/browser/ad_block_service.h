@@ -48,7 +48,7 @@ class AdBlockService : public AdBlockBaseService {
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
                         const std::string& manifest) override;
-  void OnResourcesFileDataReady(const std::string& resources);
+  void OnResourcesFileDataReady(std::string resources);
 
  private:
   friend class ::AdBlockServiceTest;
@@ -3,6 +3,7 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "base/bind.h"
 #include "base/path_service.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
@@ -14,6 +15,7 @@
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -22,6 +24,7 @@
 #include "chrome/browser/ui/browser.h"
 #include "chrome/common/chrome_features.h"
 #include "chrome/test/base/ui_test_utils.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
@@ -437,6 +440,59 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoSameAdsGetCountedAsOne) {
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
+// Load a page with several of the same adblocked xhr requests, it should only
+// write the pref once and notify the shields panel with a single batch.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SameAdsGetDispatchedInOneBatch) {
+  SetDefaultComponentIdAndBase64PublicKeyForTest(
+      kDefaultAdBlockComponentTestId,
+      kDefaultAdBlockComponentTestBase64PublicKey);
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+
+  int ads_blocked_pref_writes = 0;
+  PrefChangeRegistrar pref_change_registrar;
+  pref_change_registrar.Init(browser()->profile()->GetPrefs());
+  pref_change_registrar.Add(kAdsBlocked,
+      base::BindRepeating([](int* count) { (*count)++; },
+                          &ads_blocked_pref_writes));
+
+  GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  brave_shields::BraveShieldsWebContentsObserver* observer =
+      brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+          contents);
+  ASSERT_TRUE(observer);
+  // Keep the events queued until the test flushes them
+  observer->SetBlockedEventsFlushDelayForTesting(
+      base::TimeDelta::FromHours(1));
+  observer->FlushBlockedEventsForTesting();
+  const size_t dispatched_blocked_event_count =
+      observer->GetDispatchedBlockedEventCountForTesting();
+  const size_t dispatched_blocked_event_batch_count =
+      observer->GetDispatchedBlockedEventBatchCountForTesting();
+
+  bool as_expected = false;
+  ASSERT_TRUE(ExecuteScriptAndExtractBool(contents,
+                                          "setExpectations(0, 0, 0, 0, 3, 0);"
+                                          "xhr('adbanner.js');"
+                                          "xhr('adbanner.js');"
+                                          "xhr('adbanner.js')",
+                                          &as_expected));
+  EXPECT_TRUE(as_expected);
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+  EXPECT_EQ(ads_blocked_pref_writes, 1);
+  EXPECT_EQ(observer->GetDispatchedBlockedEventBatchCountForTesting(),
+            dispatched_blocked_event_batch_count);
+
+  observer->FlushBlockedEventsForTesting();
+  EXPECT_EQ(observer->GetDispatchedBlockedEventCountForTesting(),
+            dispatched_blocked_event_count + 3);
+  EXPECT_EQ(observer->GetDispatchedBlockedEventBatchCountForTesting(),
+            dispatched_blocked_event_batch_count + 1);
+}
+
 // Load a page with different adblocked xhr requests, it should count each.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoDiffAdsGetCountedAsTwo) {
   SetDefaultComponentIdAndBase64PublicKeyForTest(
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -52,6 +53,10 @@ using content::WebContents;
 
 namespace {
 
+// Roughly one frame at 60Hz, so the shields badge still updates every frame.
+constexpr base::TimeDelta kBlockedEventsFlushDelay =
+    base::TimeDelta::FromMilliseconds(16);
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -134,7 +139,10 @@ BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
-    : WebContentsObserver(web_contents) {
+    : WebContentsObserver(web_contents),
+      blocked_events_flush_delay_(kBlockedEventsFlushDelay),
+      dispatched_blocked_event_count_(0),
+      dispatched_blocked_event_batch_count_(0) {
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(
@@ -189,6 +197,10 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedEvents();
+}
+
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
@@ -219,6 +231,51 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
   blocked_url_paths_.insert(subresource);
 }
 
+void BraveShieldsWebContentsObserver::QueueBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  pending_blocked_events_.emplace_back(block_type, subresource);
+  if (!blocked_events_timer_.IsRunning()) {
+    blocked_events_timer_.Start(FROM_HERE, blocked_events_flush_delay_, this,
+        &BraveShieldsWebContentsObserver::FlushBlockedEvents);
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEvents() {
+  blocked_events_timer_.Stop();
+
+  if (pending_blocked_events_.empty()) {
+    return;
+  }
+
+  std::vector<BlockedEvent> blocked_events;
+  blocked_events.swap(pending_blocked_events_);
+  DispatchBlockedEventsForWebContents(blocked_events, web_contents());
+  dispatched_blocked_event_count_ += blocked_events.size();
+  dispatched_blocked_event_batch_count_++;
+}
+
+void BraveShieldsWebContentsObserver::SetBlockedEventsFlushDelayForTesting(
+    base::TimeDelta delay) {
+  blocked_events_flush_delay_ = delay;
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEventsForTesting() {
+  FlushBlockedEvents();
+}
+
+size_t
+BraveShieldsWebContentsObserver::GetDispatchedBlockedEventCountForTesting()
+    const {
+  return dispatched_blocked_event_count_;
+}
+
+size_t
+BraveShieldsWebContentsObserver::GetDispatchedBlockedEventBatchCountForTesting()
+    const {
+  return dispatched_blocked_event_batch_count_;
+}
+
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     std::string block_type,
@@ -230,31 +287,39 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  if (!web_contents) {
+    return;
+  }
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprinting) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (!observer) {
+    DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+    return;
+  }
+
+  observer->QueueBlockedEvent(block_type, subresource);
+
+  if (observer->IsBlockedSubresource(subresource)) {
+    return;
+  }
+
+  observer->AddBlockedSubresource(subresource);
+  PrefService* prefs = Profile::FromBrowserContext(
+      web_contents->GetBrowserContext())->
+      GetOriginalProfile()->
+      GetPrefs();
+
+  if (block_type == kAds) {
+    prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
+  } else if (block_type == kHTTPUpgradableResources) {
+    prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
+  } else if (block_type == kJavaScript) {
+    prefs->SetUint64(kJavascriptBlocked,
+        prefs->GetUint64(kJavascriptBlocked) + 1);
+  } else if (block_type == kFingerprinting) {
+    prefs->SetUint64(kFingerprintingBlocked,
+        prefs->GetUint64(kFingerprintingBlocked) + 1);
   }
 }
 
@@ -286,6 +351,40 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   }
 #endif
 }
+
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& blocked_events,
+    WebContents* web_contents) {
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  if (!web_contents) {
+    return;
+  }
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+  EventRouter* event_router = EventRouter::Get(profile);
+  if (profile && event_router) {
+    const int tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
+    std::vector<extensions::api::brave_shields::BlockedResource> details;
+    details.reserve(blocked_events.size());
+    for (const auto& blocked_event : blocked_events) {
+      extensions::api::brave_shields::BlockedResource resource;
+      resource.tab_id = tab_id;
+      resource.block_type = blocked_event.first;
+      resource.subresource = blocked_event.second;
+      details.push_back(std::move(resource));
+    }
+    std::unique_ptr<base::ListValue> args(
+        extensions::api::brave_shields::OnBlockedBatch::Create(details)
+          .release());
+    std::unique_ptr<Event> event(
+        new Event(extensions::events::BRAVE_AD_BLOCKED_BATCH,
+          extensions::api::brave_shields::OnBlockedBatch::kEventName,
+          std::move(args)));
+    event_router->BroadcastEvent(std::move(event));
+  }
+#endif
+}
 #endif
 
 bool BraveShieldsWebContentsObserver::OnMessageReceived(
@@ -305,25 +404,13 @@ bool BraveShieldsWebContentsObserver::OnMessageReceived(
 void BraveShieldsWebContentsObserver::OnJavaScriptBlockedWithDetail(
     RenderFrameHost* render_frame_host,
     const base::string16& details) {
-  WebContents* web_contents =
-      WebContents::FromRenderFrameHost(render_frame_host);
-  if (!web_contents) {
-    return;
-  }
-  DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-      base::UTF16ToUTF8(details), web_contents);
+  QueueBlockedEvent(brave_shields::kJavaScript, base::UTF16ToUTF8(details));
 }
 
 void BraveShieldsWebContentsObserver::OnFingerprintingBlockedWithDetail(
     RenderFrameHost* render_frame_host,
     const base::string16& details) {
-  WebContents* web_contents =
-      WebContents::FromRenderFrameHost(render_frame_host);
-  if (!web_contents) {
-    return;
-  }
-  DispatchBlockedEventForWebContents(brave_shields::kFingerprinting,
-      base::UTF16ToUTF8(details), web_contents);
+  QueueBlockedEvent(brave_shields::kFingerprinting, base::UTF16ToUTF8(details));
 }
 
 // static
@@ -338,6 +425,13 @@ void BraveShieldsWebContentsObserver::RegisterProfilePrefs(
 
 void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
     content::NavigationHandle* navigation_handle) {
+  // Events for the previous page have to reach the shields panel before it
+  // resets its counts for the new page
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    FlushBlockedEvents();
+  }
+
   // when the main frame navigate away
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument() &&
@@ -9,11 +9,14 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -28,6 +31,9 @@ namespace brave_shields {
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
     public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
  public:
+  // A blocked subresource as a (block type, subresource) pair.
+  using BlockedEvent = std::pair<std::string, std::string>;
+
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
   ~BraveShieldsWebContentsObserver() override;
 
@@ -36,6 +42,11 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       const std::string& block_type,
       const std::string& subresource,
       content::WebContents* web_contents);
+  // Sends all of |blocked_events| for |web_contents| to the shields UI at
+  // once.
+  static void DispatchBlockedEventsForWebContents(
+      const std::vector<BlockedEvent>& blocked_events,
+      content::WebContents* web_contents);
   static void DispatchBlockedEvent(
       std::string block_type,
       std::string subresource,
@@ -49,6 +60,11 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
 
+  void SetBlockedEventsFlushDelayForTesting(base::TimeDelta delay);
+  void FlushBlockedEventsForTesting();
+  size_t GetDispatchedBlockedEventCountForTesting() const;
+  size_t GetDispatchedBlockedEventBatchCountForTesting() const;
+
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
   struct RenderFrameIdKey {
@@ -74,6 +90,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -94,10 +111,23 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  // Blocked events are queued and sent to the shields UI in batches so that
+  // pages which block many subresources do not send an event per request.
+  void QueueBlockedEvent(const std::string& block_type,
+                         const std::string& subresource);
+  void FlushBlockedEvents();
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
+  // Blocked events waiting for |blocked_events_timer_| to fire.
+  std::vector<BlockedEvent> pending_blocked_events_;
+  base::OneShotTimer blocked_events_timer_;
+  base::TimeDelta blocked_events_flush_delay_;
+  size_t dispatched_blocked_event_count_;
+  size_t dispatched_blocked_event_batch_count_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
 #include <string>
+#include <vector>
 
 #include "brave/browser/android/brave_shields_content_settings.h"
 #include "chrome/browser/android/tab_android.h"
@@ -33,4 +34,14 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
       tabId, block_type, subresource);
 }
 
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& blocked_events,
+    WebContents* web_contents) {
+  for (const auto& blocked_event : blocked_events) {
+    DispatchBlockedEventForWebContents(blocked_event.first,
+        blocked_event.second, web_contents);
+  }
+}
+
 }  // namespace brave_shields
@@ -0,0 +1,165 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+
+#include "base/logging.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/browser/bookmark_node.h"
+
+namespace brave_sync {
+
+namespace {
+
+std::string GetObjectId(const bookmarks::BookmarkNode* node) {
+  std::string object_id;
+  node->GetMetaInfo("object_id", &object_id);
+  return object_id;
+}
+
+}  // namespace
+
+BookmarkObjectIdIndex::BookmarkObjectIdIndex(bookmarks::BookmarkModel* model)
+    : model_(model) {
+  DCHECK(model_);
+  DCHECK(model_->loaded());
+  Rebuild();
+  model_->AddObserver(this);
+}
+
+BookmarkObjectIdIndex::~BookmarkObjectIdIndex() {
+  model_->RemoveObserver(this);
+}
+
+const bookmarks::BookmarkNode* BookmarkObjectIdIndex::Find(
+    const std::string& object_id) {
+  if (object_id.empty())
+    return nullptr;
+
+  // Permanent nodes are few and "Other Bookmarks" changes its object id
+  // without notifying observers, so they are checked directly.
+  for (const auto& permanent_node : model_->root_node()->children()) {
+    if (GetObjectId(permanent_node.get()) == object_id)
+      return permanent_node.get();
+  }
+
+  auto it = nodes_by_object_id_.find(object_id);
+  if (it == nodes_by_object_id_.end()) {
+    IndexNewObjectIds();
+    it = nodes_by_object_id_.find(object_id);
+  }
+  while (it != nodes_by_object_id_.end() &&
+         GetObjectId(it->second) != object_id) {
+    // The object id was changed without a notification.
+    AddNode(it->second);
+    IndexNewObjectIds();
+    it = nodes_by_object_id_.find(object_id);
+  }
+  return it != nodes_by_object_id_.end() ? it->second : nullptr;
+}
+
+void BookmarkObjectIdIndex::BookmarkModelLoaded(bookmarks::BookmarkModel* model,
+                                                bool ids_reassigned) {
+  Rebuild();
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeAdded(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t index) {
+  AddSubtree(parent->children()[index].get());
+}
+
+void BookmarkObjectIdIndex::OnWillRemoveBookmarks(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t old_index,
+    const bookmarks::BookmarkNode* node) {
+  RemoveSubtree(node);
+}
+
+void BookmarkObjectIdIndex::OnWillChangeBookmarkMetaInfo(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  if (!node->is_permanent_node())
+    RemoveNode(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkMetaInfoChanged(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  if (!node->is_permanent_node())
+    AddNode(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkAllUserNodesRemoved(
+    bookmarks::BookmarkModel* model,
+    const std::set<GURL>& removed_urls) {
+  Rebuild();
+}
+
+void BookmarkObjectIdIndex::Rebuild() {
+  nodes_by_object_id_.clear();
+  object_ids_by_node_.clear();
+  unindexed_nodes_.clear();
+  for (const auto& permanent_node : model_->root_node()->children()) {
+    for (const auto& child : permanent_node->children())
+      AddSubtree(child.get());
+  }
+}
+
+void BookmarkObjectIdIndex::AddSubtree(const bookmarks::BookmarkNode* node) {
+  AddNode(node);
+  for (const auto& child : node->children())
+    AddSubtree(child.get());
+}
+
+void BookmarkObjectIdIndex::RemoveSubtree(
+    const bookmarks::BookmarkNode* node) {
+  RemoveNode(node);
+  for (const auto& child : node->children())
+    RemoveSubtree(child.get());
+}
+
+void BookmarkObjectIdIndex::AddNode(const bookmarks::BookmarkNode* node) {
+  // A node added with its children is reported once per node by some
+  // operations, so it may already be indexed.
+  RemoveNode(node);
+  const std::string object_id = GetObjectId(node);
+  if (object_id.empty() ||
+      !nodes_by_object_id_.emplace(object_id, node).second) {
+    unindexed_nodes_.insert(node);
+    return;
+  }
+  object_ids_by_node_[node] = object_id;
+}
+
+void BookmarkObjectIdIndex::RemoveNode(const bookmarks::BookmarkNode* node) {
+  // The node may have changed its object id since it was indexed, so it is
+  // removed under the one it was indexed with.
+  auto it = object_ids_by_node_.find(node);
+  if (it == object_ids_by_node_.end()) {
+    unindexed_nodes_.erase(node);
+    return;
+  }
+  nodes_by_object_id_.erase(it->second);
+  object_ids_by_node_.erase(it);
+}
+
+void BookmarkObjectIdIndex::IndexNewObjectIds() {
+  for (auto it = unindexed_nodes_.begin(); it != unindexed_nodes_.end();) {
+    const bookmarks::BookmarkNode* node = *it;
+    const std::string object_id = GetObjectId(node);
+    if (object_id.empty() ||
+        !nodes_by_object_id_.emplace(object_id, node).second) {
+      ++it;
+      continue;
+    }
+    object_ids_by_node_[node] = object_id;
+    it = unindexed_nodes_.erase(it);
+  }
+}
+
+}  // namespace brave_sync
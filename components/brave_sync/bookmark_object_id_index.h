@@ -0,0 +1,104 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "components/bookmarks/browser/bookmark_model_observer.h"
+
+namespace bookmarks {
+class BookmarkModel;
+class BookmarkNode;
+}  // namespace bookmarks
+
+namespace brave_sync {
+
+// Keeps track of which bookmark node has which "object_id" meta info, so that
+// nodes can be looked up by object id without walking the whole tree.
+//
+// Object ids are not always set through BookmarkModel (AddBraveMetaInfo and
+// the "Other Bookmarks" handling write them straight into the node), so the
+// index also remembers the nodes it could not index when it last saw them and
+// checks those again when a lookup misses. Once every node has its own object
+// id, which is the usual state of a synced profile, that list is empty.
+class BookmarkObjectIdIndex : public bookmarks::BookmarkModelObserver {
+ public:
+  // |model| must be loaded and must outlive the index.
+  explicit BookmarkObjectIdIndex(bookmarks::BookmarkModel* model);
+  ~BookmarkObjectIdIndex() override;
+
+  // Returns the node with |object_id|, or nullptr if there is none. When
+  // several nodes share an object id, which MigrateDuplicatedBookmarksObjectIds
+  // fixes on startup, returns one of them.
+  const bookmarks::BookmarkNode* Find(const std::string& object_id);
+
+  // bookmarks::BookmarkModelObserver implementation
+  void BookmarkModelLoaded(bookmarks::BookmarkModel* model,
+                           bool ids_reassigned) override;
+  void BookmarkNodeMoved(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* old_parent,
+                         size_t old_index,
+                         const bookmarks::BookmarkNode* new_parent,
+                         size_t new_index) override {}
+  void BookmarkNodeAdded(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* parent,
+                         size_t index) override;
+  void OnWillRemoveBookmarks(bookmarks::BookmarkModel* model,
+                             const bookmarks::BookmarkNode* parent,
+                             size_t old_index,
+                             const bookmarks::BookmarkNode* node) override;
+  void BookmarkNodeRemoved(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* parent,
+      size_t old_index,
+      const bookmarks::BookmarkNode* node,
+      const std::set<GURL>& no_longer_bookmarked) override {}
+  void BookmarkNodeChanged(bookmarks::BookmarkModel* model,
+                           const bookmarks::BookmarkNode* node) override {}
+  void OnWillChangeBookmarkMetaInfo(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override;
+  void BookmarkMetaInfoChanged(bookmarks::BookmarkModel* model,
+                               const bookmarks::BookmarkNode* node) override;
+  void BookmarkNodeFaviconChanged(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override {}
+  void BookmarkNodeChildrenReordered(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override {}
+  void BookmarkAllUserNodesRemoved(
+      bookmarks::BookmarkModel* model,
+      const std::set<GURL>& removed_urls) override;
+
+ private:
+  void Rebuild();
+  void AddSubtree(const bookmarks::BookmarkNode* node);
+  void RemoveSubtree(const bookmarks::BookmarkNode* node);
+  void AddNode(const bookmarks::BookmarkNode* node);
+  void RemoveNode(const bookmarks::BookmarkNode* node);
+  // Indexes the nodes in |unindexed_nodes_| which have been given an object
+  // id since they were last looked at.
+  void IndexNewObjectIds();
+
+  bookmarks::BookmarkModel* model_;  // Not owned
+  std::unordered_map<std::string, const bookmarks::BookmarkNode*>
+      nodes_by_object_id_;
+  // The object id each node in |nodes_by_object_id_| is indexed under.
+  std::unordered_map<const bookmarks::BookmarkNode*, std::string>
+      object_ids_by_node_;
+  // Nodes which have no object id, or share it with an indexed node.
+  std::set<const bookmarks::BookmarkNode*> unindexed_nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(BookmarkObjectIdIndex);
+};
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
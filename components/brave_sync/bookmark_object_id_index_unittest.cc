@@ -0,0 +1,175 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_sync/tools.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/browser/bookmark_node.h"
+#include "components/bookmarks/test/test_bookmark_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using bookmarks::BookmarkModel;
+using bookmarks::BookmarkNode;
+
+namespace brave_sync {
+
+namespace {
+
+std::string ObjectIdForNumber(int number) {
+  return "object_id_" + base::NumberToString(number);
+}
+
+}  // namespace
+
+class BookmarkObjectIdIndexTest : public testing::Test {
+ public:
+  BookmarkObjectIdIndexTest()
+      : model_(bookmarks::TestBookmarkClient::CreateModel()) {}
+  ~BookmarkObjectIdIndexTest() override {}
+
+ protected:
+  BookmarkModel* model() { return model_.get(); }
+
+  const BookmarkNode* AddURL(const BookmarkNode* parent,
+                             const std::string& object_id) {
+    const BookmarkNode* node = model_->AddURL(
+        parent, parent->children().size(), base::ASCIIToUTF16(object_id),
+        GURL("https://a.com/" + object_id));
+    if (!object_id.empty())
+      model_->SetNodeMetaInfo(node, "object_id", object_id);
+    return node;
+  }
+
+ private:
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<BookmarkModel> model_;
+};
+
+TEST_F(BookmarkObjectIdIndexTest, FindsExistingNodes) {
+  const BookmarkNode* folder =
+      model()->AddFolder(model()->bookmark_bar_node(), 0,
+                         base::ASCIIToUTF16("Folder"));
+  model()->SetNodeMetaInfo(folder, "object_id", "folder");
+  const BookmarkNode* a = AddURL(folder, "a");
+  const BookmarkNode* b = AddURL(model()->other_node(), "b");
+  AddURL(model()->other_node(), std::string());
+  tools::AsMutable(model()->other_node())->SetMetaInfo("object_id", "other");
+
+  BookmarkObjectIdIndex index(model());
+  EXPECT_EQ(index.Find("folder"), folder);
+  EXPECT_EQ(index.Find("a"), a);
+  EXPECT_EQ(index.Find("b"), b);
+  EXPECT_EQ(index.Find("other"), model()->other_node());
+  EXPECT_EQ(index.Find("c"), nullptr);
+  EXPECT_EQ(index.Find(std::string()), nullptr);
+}
+
+TEST_F(BookmarkObjectIdIndexTest, FollowsModelChanges) {
+  BookmarkObjectIdIndex index(model());
+
+  const BookmarkNode* folder =
+      model()->AddFolder(model()->bookmark_bar_node(), 0,
+                         base::ASCIIToUTF16("Folder"));
+  model()->SetNodeMetaInfo(folder, "object_id", "folder");
+  const BookmarkNode* a = AddURL(folder, "a");
+  const BookmarkNode* b = AddURL(folder, "b");
+  EXPECT_EQ(index.Find("folder"), folder);
+  EXPECT_EQ(index.Find("a"), a);
+  EXPECT_EQ(index.Find("b"), b);
+
+  model()->SetNodeMetaInfo(a, "object_id", "a2");
+  EXPECT_EQ(index.Find("a"), nullptr);
+  EXPECT_EQ(index.Find("a2"), a);
+
+  model()->Move(b, model()->other_node(), 0);
+  EXPECT_EQ(index.Find("b"), b);
+
+  // Removing a folder removes its children as well.
+  model()->Remove(folder);
+  EXPECT_EQ(index.Find("folder"), nullptr);
+  EXPECT_EQ(index.Find("a2"), nullptr);
+  EXPECT_EQ(index.Find("b"), b);
+
+  model()->RemoveAllUserBookmarks();
+  EXPECT_EQ(index.Find("b"), nullptr);
+  const BookmarkNode* c = AddURL(model()->other_node(), "c");
+  EXPECT_EQ(index.Find("c"), c);
+}
+
+// AddBraveMetaInfo and the "Other Bookmarks" handling set object ids without
+// notifying BookmarkModel observers.
+TEST_F(BookmarkObjectIdIndexTest, FindsObjectIdsSetWithoutNotification) {
+  const BookmarkNode* a = AddURL(model()->bookmark_bar_node(), std::string());
+  BookmarkObjectIdIndex index(model());
+  const BookmarkNode* b = AddURL(model()->bookmark_bar_node(), std::string());
+
+  tools::AsMutable(a)->SetMetaInfo("object_id", "a");
+  tools::AsMutable(b)->SetMetaInfo("object_id", "b");
+  EXPECT_EQ(index.Find("a"), a);
+  EXPECT_EQ(index.Find("b"), b);
+
+  tools::AsMutable(model()->other_node())->SetMetaInfo("object_id", "other1");
+  EXPECT_EQ(index.Find("other1"), model()->other_node());
+  tools::AsMutable(model()->other_node())->SetMetaInfo("object_id", "other2");
+  EXPECT_EQ(index.Find("other1"), nullptr);
+  EXPECT_EQ(index.Find("other2"), model()->other_node());
+
+  tools::AsMutable(a)->SetMetaInfo("object_id", "a2");
+  EXPECT_EQ(index.Find("a"), nullptr);
+  EXPECT_EQ(index.Find("a2"), a);
+  model()->Remove(a);
+  EXPECT_EQ(index.Find("a2"), nullptr);
+}
+
+TEST_F(BookmarkObjectIdIndexTest, DuplicatedObjectIds) {
+  const BookmarkNode* a1 = AddURL(model()->bookmark_bar_node(), "a");
+  const BookmarkNode* a2 = AddURL(model()->bookmark_bar_node(), "a");
+  BookmarkObjectIdIndex index(model());
+
+  const BookmarkNode* found = index.Find("a");
+  EXPECT_TRUE(found == a1 || found == a2);
+  model()->Remove(found);
+  EXPECT_EQ(index.Find("a"), found == a1 ? a2 : a1);
+}
+
+// Resolves 1000 records against a profile with 50000 bookmarks.
+TEST_F(BookmarkObjectIdIndexTest, LargeModel) {
+  const int kFolders = 50;
+  const int kBookmarksPerFolder = 1000;
+  const int kBookmarks = kFolders * kBookmarksPerFolder;
+  const int kRecords = 1000;
+  std::vector<const BookmarkNode*> nodes;
+  for (int i = 0; i < kFolders; ++i) {
+    const BookmarkNode* folder = model()->AddFolder(
+        model()->bookmark_bar_node(), i,
+        base::ASCIIToUTF16("Folder" + base::NumberToString(i)));
+    for (int j = 0; j < kBookmarksPerFolder; ++j) {
+      nodes.push_back(
+          AddURL(folder, ObjectIdForNumber(i * kBookmarksPerFolder + j)));
+    }
+  }
+  BookmarkObjectIdIndex index(model());
+
+  // Every other record is for a bookmark which doesn't exist yet.
+  for (int i = 0; i < kRecords; ++i) {
+    if (i % 2) {
+      const int number = i * 97 % kBookmarks;
+      EXPECT_EQ(index.Find(ObjectIdForNumber(number)), nodes[number]);
+    } else {
+      EXPECT_EQ(index.Find(ObjectIdForNumber(kBookmarks + i)), nullptr);
+    }
+  }
+}
+
+}  // namespace brave_sync
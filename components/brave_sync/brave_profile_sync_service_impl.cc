@@ -16,6 +16,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
 #include "brave/components/brave_sync/brave_sync_service_observer.h"
 #include "brave/components/brave_sync/client/brave_sync_client_impl.h"
@@ -36,7 +37,6 @@
 #include "components/sync/engine_impl/syncer.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/network_interfaces.h"
-#include "ui/base/models/tree_node_iterator.h"
 
 namespace brave_sync {
 
@@ -106,21 +106,6 @@ RecordsListPtr CreateDeviceRecord(const std::string& device_name,
   return records;
 }
 
-const bookmarks::BookmarkNode* FindByObjectId(bookmarks::BookmarkModel* model,
-                                              const std::string& object_id) {
-  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(
-      model->root_node());
-  while (iterator.has_next()) {
-    const bookmarks::BookmarkNode* node = iterator.Next();
-    std::string node_object_id;
-    node->GetMetaInfo("object_id", &node_object_id);
-
-    if (!node_object_id.empty() && object_id == node_object_id)
-      return node;
-  }
-  return nullptr;
-}
-
 std::unique_ptr<SyncRecord> CreateDeleteBookmarkByObjectId(
     const prefs::Prefs* brave_sync_prefs,
     const std::string& object_id) {
@@ -750,6 +735,7 @@ void BraveProfileSyncServiceImpl::OnConnectionChanged(
 
 void BraveProfileSyncServiceImpl::Shutdown() {
   SignalWaitableEvent();
+  object_id_index_.reset();
   syncer::ProfileSyncService::Shutdown();
 }
 
@@ -884,7 +870,7 @@ BraveProfileSyncServiceImpl::BookmarkNodeToSyncBookmark(
 
 void BraveProfileSyncServiceImpl::SaveSyncEntityInfo(
     const jslib::SyncRecord* record) {
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = GetObjectIdIndex()->Find(record->objectId);
   // no need to save for DELETE
   if (node) {
     auto& bookmark = record->GetBookmark();
@@ -909,7 +895,7 @@ void BraveProfileSyncServiceImpl::LoadSyncEntityInfo(
   auto* bookmark = record->mutable_bookmark();
   if (!bookmark->metaInfo.empty())
     return;
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = GetObjectIdIndex()->Find(record->objectId);
   if (node) {
     AddSyncEntityInfo(bookmark, node, "position_in_parent");
     AddSyncEntityInfo(bookmark, node, "version");
@@ -1046,6 +1032,14 @@ void BraveProfileSyncServiceImpl::CheckOtherBookmarkChildRecord(
   }
 }
 
+BookmarkObjectIdIndex* BraveProfileSyncServiceImpl::GetObjectIdIndex() {
+  DCHECK(model_);
+  DCHECK(model_->loaded());
+  if (!object_id_index_)
+    object_id_index_ = std::make_unique<BookmarkObjectIdIndex>(model_);
+  return object_id_index_.get();
+}
+
 void BraveProfileSyncServiceImpl::CreateResolveList(
     const std::vector<std::unique_ptr<SyncRecord>>& records,
     SyncRecordAndExistingList* records_and_existing_objects) {
@@ -1059,7 +1053,7 @@ void BraveProfileSyncServiceImpl::CreateResolveList(
     }
     auto resolved_record = std::make_unique<SyncRecordAndExisting>();
     resolved_record->first = SyncRecord::Clone(*record);
-    auto* node = FindByObjectId(model_, record->objectId);
+    auto* node = GetObjectIdIndex()->Find(record->objectId);
     if (node) {
       resolved_record->second = BookmarkNodeToSyncBookmark(node);
     }
@@ -1332,7 +1326,7 @@ void BraveProfileSyncServiceImpl::ResendSyncRecords(
     DCHECK(model_->loaded());
 
     for (auto& object_id : records_to_resend) {
-      auto* node = FindByObjectId(model_, object_id);
+      auto* node = GetObjectIdIndex()->Find(object_id);
 
       // Check resend interval
       const base::DictionaryValue* meta =
@@ -71,6 +71,8 @@ namespace prefs {
 class Prefs;
 }  // namespace prefs
 
+class BookmarkObjectIdIndex;
+
 using bookmarks::BookmarkModel;
 using bookmarks::BookmarkNode;
 
@@ -279,6 +281,9 @@ class BraveProfileSyncServiceImpl
   void CheckOtherBookmarkRecord(jslib::SyncRecord* record);
   void CheckOtherBookmarkChildRecord(jslib::SyncRecord* record);
 
+  // Created on first use, the bookmark model must be loaded by then
+  BookmarkObjectIdIndex* GetObjectIdIndex();
+
   void CreateResolveList(
       const std::vector<std::unique_ptr<jslib::SyncRecord>>& records,
       SyncRecordAndExistingList* records_and_existing_objects);
@@ -328,6 +333,9 @@ class BraveProfileSyncServiceImpl
 
   bookmarks::BookmarkModel* model_ = nullptr;
 
+  // Finds bookmarks by object id while resolving records
+  std::unique_ptr<BookmarkObjectIdIndex> object_id_index_;
+
   std::unique_ptr<BraveSyncClient> brave_sync_client_;
 
   std::unique_ptr<RecordsList> pending_received_records_;
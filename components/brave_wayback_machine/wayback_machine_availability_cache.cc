@@ -0,0 +1,145 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wayback_machine/wayback_machine_availability_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "brave/components/brave_wayback_machine/url_constants.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/storage_partition.h"
+#include "net/base/load_flags.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+
+namespace {
+
+constexpr char kWaybackMachineAvailabilityCacheKey[] =
+    "wayback_machine_availability_cache";
+
+constexpr int kMaxBodySize = 1024 * 1024;
+constexpr size_t kMaxCachedAnswers = 100;
+
+// Snapshots are rarely added for a page which is already failing, so answers
+// can be kept for a while. Pages without a snapshot are checked again sooner.
+constexpr base::TimeDelta kFoundAnswerLifetime = base::TimeDelta::FromHours(1);
+constexpr base::TimeDelta kNotFoundAnswerLifetime =
+    base::TimeDelta::FromMinutes(10);
+
+const net::NetworkTrafficAnnotationTag& GetNetworkTrafficAnnotationTag() {
+  static const net::NetworkTrafficAnnotationTag network_traffic_annotation_tag =
+      net::DefineNetworkTrafficAnnotation("wayback_machine_infobar", R"(
+        semantics {
+          sender:
+            "Brave Wayback Machine"
+          description:
+            "Download wayback url"
+          trigger:
+            "When user gets 404 page"
+          data: "current tab's url"
+          destination: WEBSITE
+        }
+        policy {
+          cookies_allowed: NO
+          policy_exception_justification:
+            "Not implemented."
+        })");
+  return network_traffic_annotation_tag;
+}
+
+}  // namespace
+
+WaybackMachineAvailabilityCache::PendingFetch::PendingFetch() = default;
+
+WaybackMachineAvailabilityCache::PendingFetch::~PendingFetch() = default;
+
+// static
+WaybackMachineAvailabilityCache*
+WaybackMachineAvailabilityCache::GetForBrowserContext(
+    content::BrowserContext* context) {
+  auto* cache = static_cast<WaybackMachineAvailabilityCache*>(
+      context->GetUserData(kWaybackMachineAvailabilityCacheKey));
+  if (!cache) {
+    auto new_cache = std::make_unique<WaybackMachineAvailabilityCache>(
+        content::BrowserContext::GetDefaultStoragePartition(context)->
+            GetURLLoaderFactoryForBrowserProcess());
+    cache = new_cache.get();
+    context->SetUserData(kWaybackMachineAvailabilityCacheKey,
+                         std::move(new_cache));
+  }
+  return cache;
+}
+
+WaybackMachineAvailabilityCache::WaybackMachineAvailabilityCache(
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    : url_loader_factory_(std::move(url_loader_factory)),
+      query_url_(kWaybackQueryURL),
+      answers_(kMaxCachedAnswers) {
+}
+
+WaybackMachineAvailabilityCache::~WaybackMachineAvailabilityCache() {
+}
+
+void WaybackMachineAvailabilityCache::Fetch(const GURL& url,
+                                            FetchCallback callback) {
+  auto answer = answers_.Get(url);
+  if (answer != answers_.end()) {
+    if (answer->second.expiry > base::TimeTicks::Now()) {
+      std::move(callback).Run(answer->second.latest_wayback_url);
+      return;
+    }
+    answers_.Erase(answer);
+  }
+
+  PendingFetch& pending_fetch = pending_fetches_[url];
+  pending_fetch.callbacks.push_back(std::move(callback));
+  if (pending_fetch.loader)
+    return;
+
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = GURL(query_url_ + url.spec());
+  request->load_flags =
+      net::LOAD_DO_NOT_SEND_COOKIES | net::LOAD_DO_NOT_SAVE_COOKIES;
+  pending_fetch.loader = network::SimpleURLLoader::Create(
+      std::move(request), GetNetworkTrafficAnnotationTag());
+  // Unretained is safe because |this| owns the loader.
+  pending_fetch.loader->DownloadToString(
+      url_loader_factory_.get(),
+      base::BindOnce(&WaybackMachineAvailabilityCache::OnWaybackURLFetched,
+                     base::Unretained(this),
+                     url),
+      kMaxBodySize);
+}
+
+void WaybackMachineAvailabilityCache::OnWaybackURLFetched(
+    const GURL& url,
+    std::unique_ptr<std::string> response_body) {
+  GURL latest_wayback_url;
+  if (response_body) {
+    const auto result = base::JSONReader::Read(*response_body);
+    const base::Value* wayback_url =
+        result ? result->FindPath("archived_snapshots.closest.url") : nullptr;
+    if (wayback_url && wayback_url->is_string())
+      latest_wayback_url = GURL(wayback_url->GetString());
+
+    // Failed requests aren't kept, so that they are retried next time.
+    answers_.Put(url, {latest_wayback_url,
+                       base::TimeTicks::Now() +
+                           (latest_wayback_url.is_valid()
+                                ? kFoundAnswerLifetime
+                                : kNotFoundAnswerLifetime)});
+  }
+
+  auto it = pending_fetches_.find(url);
+  DCHECK(it != pending_fetches_.end());
+  std::vector<FetchCallback> callbacks = std::move(it->second.callbacks);
+  pending_fetches_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(latest_wayback_url);
+}
@@ -0,0 +1,82 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WAYBACK_MACHINE_WAYBACK_MACHINE_AVAILABILITY_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_WAYBACK_MACHINE_WAYBACK_MACHINE_AVAILABILITY_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace content {
+class BrowserContext;
+}  // namespace content
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+// Looks up the latest archived snapshot of a URL, sharing the answers between
+// all tabs of a profile. Answers are kept for a while, and lookups for a URL
+// which is already being looked up wait for that request instead of sending
+// another one.
+class WaybackMachineAvailabilityCache : public base::SupportsUserData::Data {
+ public:
+  // |latest_wayback_url| is empty if there is no snapshot or the lookup failed.
+  using FetchCallback =
+      base::OnceCallback<void(const GURL& latest_wayback_url)>;
+
+  static WaybackMachineAvailabilityCache* GetForBrowserContext(
+      content::BrowserContext* context);
+
+  explicit WaybackMachineAvailabilityCache(
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+  ~WaybackMachineAvailabilityCache() override;
+
+  WaybackMachineAvailabilityCache(const WaybackMachineAvailabilityCache&) =
+      delete;
+  WaybackMachineAvailabilityCache& operator=(
+      const WaybackMachineAvailabilityCache&) = delete;
+
+  void Fetch(const GURL& url, FetchCallback callback);
+
+  // Lets tests use a local server in place of the availability API.
+  void set_query_url_for_testing(const std::string& query_url) {
+    query_url_ = query_url;
+  }
+
+ private:
+  struct CachedAnswer {
+    GURL latest_wayback_url;
+    base::TimeTicks expiry;
+  };
+
+  struct PendingFetch {
+    PendingFetch();
+    ~PendingFetch();
+
+    std::unique_ptr<network::SimpleURLLoader> loader;
+    std::vector<FetchCallback> callbacks;
+  };
+
+  void OnWaybackURLFetched(const GURL& url,
+                           std::unique_ptr<std::string> response_body);
+
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  std::string query_url_;
+  base::MRUCache<GURL, CachedAnswer> answers_;
+  std::map<GURL, PendingFetch> pending_fetches_;
+};
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WAYBACK_MACHINE_WAYBACK_MACHINE_AVAILABILITY_CACHE_H_
@@ -0,0 +1,131 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wayback_machine/wayback_machine_availability_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kQueryURL[] = "https://archive.test/wayback/available?url=";
+constexpr char kPageURL[] = "https://example.com/gone";
+constexpr char kSnapshotURL[] =
+    "https://web.archive.org/web/20200101000000/https://example.com/gone";
+
+std::string GetQueryURL(const std::string& url) {
+  return kQueryURL + url;
+}
+
+std::string GetFoundResponse() {
+  return std::string(R"({"archived_snapshots": {"closest": {"url": ")") +
+         kSnapshotURL + R"("}}})";
+}
+
+}  // namespace
+
+class WaybackMachineAvailabilityCacheTest : public testing::Test {
+ public:
+  WaybackMachineAvailabilityCacheTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        cache_(base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+            &test_url_loader_factory_)) {
+    cache_.set_query_url_for_testing(kQueryURL);
+  }
+
+ protected:
+  // Starts a fetch whose answer is appended to |answers_|.
+  void Fetch(const std::string& url) {
+    cache_.Fetch(GURL(url),
+                 base::BindOnce(
+                     [](std::vector<GURL>* answers, const GURL& answer) {
+                       answers->push_back(answer);
+                     },
+                     &answers_));
+  }
+
+  int NumPendingRequests() {
+    return test_url_loader_factory_.NumPending();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory test_url_loader_factory_;
+  WaybackMachineAvailabilityCache cache_;
+  std::vector<GURL> answers_;
+};
+
+TEST_F(WaybackMachineAvailabilityCacheTest, ConcurrentFetchesShareRequest) {
+  const int kTabCount = 10;
+  for (int i = 0; i < kTabCount; ++i)
+    Fetch(kPageURL);
+  EXPECT_EQ(1, NumPendingRequests());
+  EXPECT_TRUE(answers_.empty());
+
+  test_url_loader_factory_.AddResponse(GetQueryURL(kPageURL),
+                                       GetFoundResponse());
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(static_cast<size_t>(kTabCount), answers_.size());
+  for (const auto& answer : answers_)
+    EXPECT_EQ(GURL(kSnapshotURL), answer);
+  EXPECT_EQ(0, NumPendingRequests());
+}
+
+TEST_F(WaybackMachineAvailabilityCacheTest, FoundAnswerIsCached) {
+  test_url_loader_factory_.AddResponse(GetQueryURL(kPageURL),
+                                       GetFoundResponse());
+  Fetch(kPageURL);
+  task_environment_.RunUntilIdle();
+  test_url_loader_factory_.ClearResponses();
+
+  // Answered without a request.
+  Fetch(kPageURL);
+  EXPECT_EQ(0, NumPendingRequests());
+  ASSERT_EQ(2u, answers_.size());
+  EXPECT_EQ(GURL(kSnapshotURL), answers_[1]);
+
+  // Asked again once the answer is stale.
+  task_environment_.FastForwardBy(base::TimeDelta::FromHours(2));
+  Fetch(kPageURL);
+  EXPECT_EQ(1, NumPendingRequests());
+}
+
+TEST_F(WaybackMachineAvailabilityCacheTest, NotFoundAnswerIsCachedBriefly) {
+  test_url_loader_factory_.AddResponse(GetQueryURL(kPageURL),
+                                       R"({"archived_snapshots": {}})");
+  Fetch(kPageURL);
+  task_environment_.RunUntilIdle();
+  test_url_loader_factory_.ClearResponses();
+  ASSERT_EQ(1u, answers_.size());
+  EXPECT_TRUE(answers_[0].is_empty());
+
+  Fetch(kPageURL);
+  EXPECT_EQ(0, NumPendingRequests());
+  EXPECT_EQ(2u, answers_.size());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(30));
+  Fetch(kPageURL);
+  EXPECT_EQ(1, NumPendingRequests());
+}
+
+TEST_F(WaybackMachineAvailabilityCacheTest, FailedFetchIsNotCached) {
+  test_url_loader_factory_.AddResponse(GetQueryURL(kPageURL), "",
+                                       net::HTTP_INTERNAL_SERVER_ERROR);
+  Fetch(kPageURL);
+  task_environment_.RunUntilIdle();
+  test_url_loader_factory_.ClearResponses();
+  ASSERT_EQ(1u, answers_.size());
+  EXPECT_TRUE(answers_[0].is_empty());
+
+  Fetch(kPageURL);
+  EXPECT_EQ(1, NumPendingRequests());
+}
@@ -16,16 +16,20 @@
 #include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "brave/common/brave_features.h"
 #include "brave/common/brave_switches.h"
@@ -33,6 +37,7 @@
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "chrome/common/chrome_paths.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/extension_system.h"
@@ -47,44 +52,24 @@ using extensions::Manifest;
 
 namespace {
 
-// Wraps a Greaselion rule in a component. The component is stored as an
-// unpacked extension in the system temp dir. Returns a valid extension that the
-// caller should take ownership of, or nullptr.
-//
-// NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
-    greaselion::GreaselionRule* rule,
-    const base::FilePath& extensions_dir) {
-  base::FilePath install_temp_dir =
-      extensions::file_util::GetInstallTempDir(extensions_dir);
-  if (install_temp_dir.empty()) {
-    LOG(ERROR) << "Could not get path to profile temp directory";
-    return nullptr;
-  }
-
-  base::ScopedTempDir temp_dir;
-  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
-    LOG(ERROR) << "Could not create Greaselion temp directory";
-    return nullptr;
-  }
+constexpr char kGreaselionCacheDirectoryName[] = "Greaselion";
 
-  // Create the manifest
-  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
+// Cached extensions which have not been used for this long are deleted.
+constexpr base::TimeDelta kUnusedCachedExtensionLifetime =
+    base::TimeDelta::FromDays(30);
 
-  // manifest version is always 2
-  // see kModernManifestVersion in src/extensions/common/extension.cc
-  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
+// Must be bumped whenever the way rules are converted to extensions changes,
+// so that extensions converted by an older version are not reused.
+constexpr char kGreaselionConversionVersion[] = "1";
 
-  // Create the public key.
+std::string GetPublicKeyForRule(const greaselion::GreaselionRule& rule) {
   // Greaselion scripts are not signed, but the public key for an extension
   // doubles as its unique identity, and we need one of those, so we add the
   // rule name to a known Brave domain and hash the result to create a
   // public key.
   char raw[crypto::kSHA256Length] = {0};
   std::string key;
-  std::string script_name = rule->name();
+  std::string script_name = rule.name();
   const base::CommandLine& command_line =
       *base::CommandLine::ForCurrentProcess();
   if (!command_line.HasSwitch(switches::kUseGoUpdateDev) &&
@@ -98,18 +83,60 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
                              crypto::kSHA256Length);
   }
   base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  return key;
+}
+
+// Returns a hash of everything the extension converted from |rule| is made
+// of, which names the directory the converted extension is cached in.
+std::string HashGreaselionRule(const greaselion::GreaselionRule& rule,
+                               const std::string& public_key,
+                               const std::vector<std::string>& scripts) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  // Each part is followed by a NUL so that parts can't run into each other.
+  auto update = [&hash](const std::string& part) {
+    hash->Update(part.c_str(), part.size() + 1);
+  };
+  update(kGreaselionConversionVersion);
+  update(rule.name());
+  update(public_key);
+  update(rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    update(url_pattern);
+  for (size_t i = 0; i < scripts.size(); i++) {
+    update(rule.scripts()[i].BaseName().AsUTF8Unsafe());
+    update(base::NumberToString(scripts[i].size()));
+    hash->Update(scripts[i].data(), scripts[i].size());
+  }
+
+  uint8_t result[crypto::kSHA256Length];
+  hash->Finish(result, sizeof(result));
+  return base::ToLowerASCII(base::HexEncode(result, sizeof(result)));
+}
+
+// Writes the extension for |rule| to |extension_dir|.
+bool WriteGreaselionExtension(const greaselion::GreaselionRule& rule,
+                              const std::string& public_key,
+                              const std::vector<std::string>& scripts,
+                              const base::FilePath& extension_dir) {
+  // Create the manifest
+  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
 
-  root->SetStringPath(extensions::manifest_keys::kName, script_name);
+  // manifest version is always 2
+  // see kModernManifestVersion in src/extensions/common/extension.cc
+  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
+
+  root->SetStringPath(extensions::manifest_keys::kName, rule.name());
   root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
   root->SetStringPath(extensions::manifest_keys::kDescription, "");
-  root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
+  root->SetStringPath(extensions::manifest_keys::kPublicKey, public_key);
 
   auto js_files = std::make_unique<base::ListValue>();
-  for (auto script : rule->scripts())
+  for (auto script : rule.scripts())
     js_files->AppendString(script.BaseName().value());
 
   auto matches = std::make_unique<base::ListValue>();
-  for (auto url_pattern : rule->url_patterns())
+  for (auto url_pattern : rule.url_patterns())
     matches->AppendString(url_pattern);
 
   auto content_script = std::make_unique<base::DictionaryValue>();
@@ -117,7 +144,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   content_script->Set(extensions::manifest_keys::kJs, std::move(js_files));
   // All Greaselion scripts default to document end.
   content_script->SetStringPath(extensions::manifest_keys::kRunAt,
-      rule->run_at() == extensions::manifest_values::kRunAtDocumentStart
+      rule.run_at() == extensions::manifest_values::kRunAtDocumentStart
         ? extensions::manifest_values::kRunAtDocumentStart
         : extensions::manifest_values::kRunAtDocumentEnd);
 
@@ -128,7 +155,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
             std::move(content_scripts));
 
   base::FilePath manifest_path =
-      temp_dir.GetPath().Append(extensions::kManifestFilename);
+      extension_dir.Append(extensions::kManifestFilename);
   JSONFileValueSerializer serializer(manifest_path);
   // If you read the header file for this function, it says not to use it
   // outside unit tests because it writes to disk (which blocks the thread). I
@@ -137,30 +164,119 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return nullptr;
+    return false;
   }
 
-  // Copy the script files to our extension directory.
-  for (auto script : rule->scripts()) {
-    if (!base::CopyFile(script, temp_dir.GetPath().Append(script.BaseName()))) {
+  // Write the script files to our extension directory. The contents that
+  // were hashed are written, rather than copying the files again.
+  for (size_t i = 0; i < scripts.size(); i++) {
+    const base::FilePath& script = rule.scripts()[i];
+    if (base::WriteFile(extension_dir.Append(script.BaseName()),
+                        scripts[i].data(), scripts[i].size()) !=
+        static_cast<int>(scripts[i].size())) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Wraps a Greaselion rule in a component. The component is stored as an
+// unpacked extension in |cache_dir|, in a directory named after a hash of the
+// rule and its scripts, so an extension converted earlier from the same rule
+// and scripts is loaded from there instead of being converted again. Returns a
+// valid extension that the caller should take ownership of, or nullptr.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
+    greaselion::GreaselionRule* rule,
+    const base::FilePath& extensions_dir,
+    const base::FilePath& cache_dir) {
+  std::vector<std::string> scripts;
+  for (const auto& script : rule->scripts()) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents)) {
+      LOG(ERROR) << "Could not read Greaselion script at path: "
+          << script.LossyDisplayName();
       return nullptr;
     }
+    scripts.push_back(std::move(contents));
   }
 
+  const std::string public_key = GetPublicKeyForRule(*rule);
+  const base::FilePath extension_dir =
+      cache_dir.AppendASCII(HashGreaselionRule(*rule, public_key, scripts));
+
   std::string error;
+  if (base::PathExists(extension_dir)) {
+    scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+        extension_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+    if (extension.get()) {
+      // Marks the extension as used, see
+      // DeleteStaleCachedExtensionsOnTaskRunner().
+      const base::Time now = base::Time::Now();
+      base::TouchFile(extension_dir, now, now);
+      return extension;
+    }
+    LOG(WARNING) << "Could not load cached Greaselion extension, converting "
+                 << "it again: " << error;
+    base::DeleteFile(extension_dir, true);
+  }
+
+  base::FilePath install_temp_dir =
+      extensions::file_util::GetInstallTempDir(extensions_dir);
+  if (install_temp_dir.empty()) {
+    LOG(ERROR) << "Could not get path to profile temp directory";
+    return nullptr;
+  }
+
+  // The extension is written to a temp dir and moved into the cache once it is
+  // complete, so that a partly written extension is never loaded from there.
+  base::ScopedTempDir temp_dir;
+  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
+    LOG(ERROR) << "Could not create Greaselion temp directory";
+    return nullptr;
+  }
+
+  if (!WriteGreaselionExtension(*rule, public_key, scripts,
+                                temp_dir.GetPath())) {
+    return nullptr;
+  }
+
+  if (!base::CreateDirectory(cache_dir) ||
+      !base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension to "
+        << extension_dir.LossyDisplayName();
+    return nullptr;
+  }
+  temp_dir.Take();
+
   scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+      extension_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
   if (!extension.get()) {
     LOG(ERROR) << "Could not load Greaselion extension";
     LOG(ERROR) << error;
     return nullptr;
   }
 
-  temp_dir.Take();  // The caller takes ownership of the directory.
   return extension;
 }
+
+// Deletes the cached extensions in |cache_dir| which haven't been used for a
+// while, such as those converted from earlier versions of a rule.
+void DeleteStaleCachedExtensionsOnTaskRunner(const base::FilePath& cache_dir) {
+  const base::Time cutoff = base::Time::Now() - kUnusedCachedExtensionLifetime;
+  base::FileEnumerator enumerator(cache_dir, false,
+                                  base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (enumerator.GetInfo().GetLastModifiedTime() < cutoff)
+      base::DeleteFile(path, true);
+  }
+}
+
 }  // namespace
 
 namespace greaselion {
@@ -173,17 +289,25 @@ GreaselionServiceImpl::GreaselionServiceImpl(
     scoped_refptr<base::SequencedTaskRunner> task_runner)
     : download_service_(download_service),
       install_directory_(install_directory),
+      // Outside of |install_directory_|, which extensions clear out of
+      // directories they don't know about.
+      cache_directory_(install_directory.DirName().AppendASCII(
+          kGreaselionCacheDirectoryName)),
       extension_system_(extension_system),
       extension_service_(extension_system->extension_service()),
       extension_registry_(extension_registry),
       all_rules_installed_successfully_(true),
       update_in_progress_(false),
+      pending_conversions_(0),
       pending_installs_(0),
       task_runner_(std::move(task_runner)),
       weak_factory_(this) {
   extension_registry_->AddObserver(this);
   for (int i = FIRST_FEATURE; i != LAST_FEATURE; i++)
     state_[static_cast<GreaselionFeature>(i)] = false;
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&DeleteStaleCachedExtensionsOnTaskRunner,
+                                cache_directory_));
 }
 
 GreaselionServiceImpl::~GreaselionServiceImpl() {
@@ -194,51 +318,35 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
   if (update_in_progress_)
     return;
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
-    CreateAndInstallExtensions();
-    return;
-  }
-
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
-    extension_service_->UnloadExtension(
-        id, extensions::UnloadedExtensionReason::UPDATE);
-  }
-}
-
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
-  DCHECK(update_in_progress_);
+  update_start_time_ = base::TimeTicks::Now();
   all_rules_installed_successfully_ = true;
+  updated_extensions_.clear();
+  pending_conversions_ = 0;
   pending_installs_ = 0;
+
   std::vector<std::unique_ptr<GreaselionRule>>* rules =
       download_service_->rules();
   for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
     if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+      pending_conversions_ += 1;
     }
   }
-  if (!pending_installs_) {
-    // no rules match, nothing else to do
+  if (!pending_conversions_) {
+    // no rules match, so only the installed extensions need removing
+    UnloadUnusedExtensions();
     MaybeNotifyObservers();
     return;
   }
+  pending_installs_ = pending_conversions_;
   for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
     if (rule->Matches(state_) && rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
+      // Convert script file to component extension, or find the one converted
+      // earlier. This must run on extension file task runner, which was
+      // passed in in the constructor.
       base::PostTaskAndReplyWithResult(
           task_runner_.get(), FROM_HERE,
           base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_),
+                         rule.get(), install_directory_, cache_directory_),
           base::BindOnce(&GreaselionServiceImpl::PostConvert,
                          weak_factory_.GetWeakPtr()));
     }
@@ -247,31 +355,64 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
 
 void GreaselionServiceImpl::PostConvert(
     scoped_refptr<extensions::Extension> extension) {
+  pending_conversions_ -= 1;
   if (!extension.get()) {
     all_rules_installed_successfully_ = false;
     pending_installs_ -= 1;
-    MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(extension->id());
-    extension_system_->ready().Post(
-        FROM_HERE,
-        base::BindOnce(&GreaselionServiceImpl::Install,
-                       weak_factory_.GetWeakPtr(), base::Passed(&extension)));
+    updated_extensions_.insert(extension->id());
+    auto it = greaselion_extensions_.find(extension->id());
+    if (it != greaselion_extensions_.end() &&
+        it->second == extension->path()) {
+      // Neither the rule nor its scripts have changed, so the installed
+      // extension is kept.
+      pending_installs_ -= 1;
+    } else {
+      greaselion_extensions_[extension->id()] = extension->path();
+      extension_system_->ready().Post(
+          FROM_HERE,
+          base::BindOnce(&GreaselionServiceImpl::Install,
+                         weak_factory_.GetWeakPtr(), base::Passed(&extension)));
+    }
   }
+
+  if (!pending_conversions_)
+    UnloadUnusedExtensions();
+  MaybeNotifyObservers();
 }
 
 void GreaselionServiceImpl::Install(
     scoped_refptr<extensions::Extension> extension) {
+  // An extension with the same id and version would be ignored, so the
+  // extension for the previous version of the rule is unloaded first.
+  if (extension_registry_->enabled_extensions().Contains(extension->id())) {
+    extension_service_->UnloadExtension(
+        extension->id(), extensions::UnloadedExtensionReason::UPDATE);
+  }
   extension_service_->AddExtension(extension.get());
 }
 
+void GreaselionServiceImpl::UnloadUnusedExtensions() {
+  std::vector<extensions::ExtensionId> unused_extensions;
+  for (const auto& extension : greaselion_extensions_) {
+    if (!updated_extensions_.count(extension.first))
+      unused_extensions.push_back(extension.first);
+  }
+  for (const auto& id : unused_extensions) {
+    greaselion_extensions_.erase(id);
+    extension_service_->UnloadExtension(
+        id, extensions::UnloadedExtensionReason::DISABLE);
+  }
+}
+
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!update_in_progress_)
+    return;
+  auto it = greaselion_extensions_.find(extension->id());
+  if (it == greaselion_extensions_.end() || it->second != extension->path()) {
     // not one of ours
     return;
   }
@@ -284,17 +425,12 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
-    // not one of ours
+  auto it = greaselion_extensions_.find(extension->id());
+  if (it == greaselion_extensions_.end() || it->second != extension->path()) {
+    // not one of ours, or the previous version of one being updated
     return;
   }
-  greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
-    // It's time!
-    CreateAndInstallExtensions();
-  }
+  greaselion_extensions_.erase(it);
 }
 
 void GreaselionServiceImpl::AddObserver(Observer* observer) {
@@ -306,8 +442,10 @@ void GreaselionServiceImpl::RemoveObserver(Observer* observer) {
 }
 
 void GreaselionServiceImpl::MaybeNotifyObservers() {
-  if (!pending_installs_) {
+  if (!pending_conversions_ && !pending_installs_) {
     update_in_progress_ = false;
+    UMA_HISTOGRAM_TIMES("Brave.Greaselion.UpdateInstalledExtensionsTime",
+                        base::TimeTicks::Now() - update_start_time_);
     for (Observer& observer : observers_)
       observer.OnExtensionsReady(this, all_rules_installed_successfully_);
   }
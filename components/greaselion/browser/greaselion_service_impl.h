@@ -7,12 +7,14 @@
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "url/gurl.h"
@@ -57,23 +59,31 @@ class GreaselionServiceImpl : public GreaselionService {
                            extensions::UnloadedExtensionReason reason) override;
 
  private:
-  void CreateAndInstallExtensions();
   void PostConvert(scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
+  void UnloadUnusedExtensions();
   void MaybeNotifyObservers();
 
   GreaselionDownloadService* download_service_;  // NOT OWNED
   GreaselionFeatures state_;
   const base::FilePath install_directory_;
+  // Where converted rules are kept, so that they are only converted again
+  // when the rule or its scripts change.
+  const base::FilePath cache_directory_;
   extensions::ExtensionSystem* extension_system_;      // NOT OWNED
   extensions::ExtensionService* extension_service_;    // NOT OWNED
   extensions::ExtensionRegistry* extension_registry_;  // NOT OWNED
   bool all_rules_installed_successfully_;
   bool update_in_progress_;
+  int pending_conversions_;
   int pending_installs_;
+  base::TimeTicks update_start_time_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
+  // Installed Greaselion extensions and the directory each was loaded from.
+  std::map<extensions::ExtensionId, base::FilePath> greaselion_extensions_;
+  // Extensions for the rules which match in the update in progress.
+  std::set<extensions::ExtensionId> updated_extensions_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(GreaselionServiceImpl);
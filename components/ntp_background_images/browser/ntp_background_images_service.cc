@@ -6,8 +6,10 @@
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/task/post_task.h"
@@ -26,6 +28,9 @@ namespace {
 
 constexpr char kPhotoJsonFilename[] = "photo.json";
 
+// Enough for the logo, the wallpaper being shown and the next one.
+constexpr size_t kImageCacheSize = 4;
+
 std::string ReadPhotosManifest(const base::FilePath& photos_manifest_path) {
   std::string contents;
   bool success = base::ReadFileToString(photos_manifest_path, &contents);
@@ -36,6 +41,16 @@ std::string ReadPhotosManifest(const base::FilePath& photos_manifest_path) {
   return contents;
 }
 
+scoped_refptr<base::RefCountedMemory> ReadImageFile(
+    const base::FilePath& image_file) {
+  std::string contents;
+  if (!base::ReadFileToString(image_file, &contents)) {
+    DVLOG(2) << "ReadImageFile: cannot read " << image_file;
+    return nullptr;
+  }
+  return base::RefCountedString::TakeString(&contents);
+}
+
 NTPBackgroundImagesData* GetDemoWallpaper() {
   static auto demo = std::make_unique<NTPBackgroundImagesData>();
   demo->url_prefix = "chrome://newtab/ntp-dummy-brandedwallpaper/";
@@ -54,7 +69,8 @@ NTPBackgroundImagesData* GetDemoWallpaper() {
 
 NTPBackgroundImagesService::NTPBackgroundImagesService(
     component_updater::ComponentUpdateService* cus)
-    : weak_factory_(this) {
+    : image_cache_(kImageCacheSize),
+      weak_factory_(this) {
   // Flag override for testing or demo purposes
   base::FilePath forced_local_path(
       base::CommandLine::ForCurrentProcess()->GetSwitchValueNative(
@@ -106,10 +122,55 @@ NTPBackgroundImagesService::GetBackgroundImagesData() const {
   return nullptr;
 }
 
+void NTPBackgroundImagesService::GetImage(const base::FilePath& image_file,
+                                          GetImageCallback callback) {
+  auto it = image_cache_.Get(image_file);
+  if (it != image_cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  auto& pending_callbacks = pending_image_reads_[image_file];
+  pending_callbacks.push_back(std::move(callback));
+  if (pending_callbacks.size() > 1)
+    return;
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&ReadImageFile, image_file),
+      base::BindOnce(&NTPBackgroundImagesService::OnGetImage,
+                     weak_factory_.GetWeakPtr(), image_file));
+}
+
+void NTPBackgroundImagesService::PrefetchImage(
+    const base::FilePath& image_file) {
+  if (image_cache_.Peek(image_file) != image_cache_.end() ||
+      pending_image_reads_.count(image_file))
+    return;
+
+  GetImage(image_file, base::DoNothing());
+}
+
+void NTPBackgroundImagesService::OnGetImage(
+    const base::FilePath& image_file,
+    scoped_refptr<base::RefCountedMemory> image) {
+  if (image)
+    image_cache_.Put(image_file, image);
+
+  auto it = pending_image_reads_.find(image_file);
+  if (it == pending_image_reads_.end())
+    return;
+  std::vector<GetImageCallback> callbacks = std::move(it->second);
+  pending_image_reads_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(image);
+}
+
 void NTPBackgroundImagesService::OnComponentReady(
     const base::FilePath& installed_dir) {
   // image list is no longer valid after the component has been updated
   images_data_.reset();
+  image_cache_.Clear();
   installed_dir_ = installed_dir;
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
@@ -122,6 +183,11 @@ void NTPBackgroundImagesService::OnComponentReady(
 void NTPBackgroundImagesService::OnGetPhotoJsonData(
     const std::string& photo_json) {
   images_data_.reset(new NTPBackgroundImagesData(photo_json, installed_dir_));
+  // Load the images the first branded new tab will show.
+  if (images_data_->IsValid()) {
+    PrefetchImage(images_data_->logo_image_file);
+    PrefetchImage(images_data_->backgrounds[0].image_file);
+  }
   NotifyObservers();
 }
 
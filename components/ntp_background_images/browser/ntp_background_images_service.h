@@ -6,11 +6,16 @@
 #ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SERVICE_H_
 #define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SERVICE_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/callback_forward.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 
@@ -32,6 +37,9 @@ class NTPBackgroundImagesService {
     virtual ~Observer() {}
   };
 
+  using GetImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
   explicit NTPBackgroundImagesService(
       component_updater::ComponentUpdateService* cus);
   ~NTPBackgroundImagesService();
@@ -46,8 +54,16 @@ class NTPBackgroundImagesService {
 
   NTPBackgroundImagesData* GetBackgroundImagesData() const;
 
+  // Runs |callback| with the contents of |image_file|, or null if it can't be
+  // read. Recently used images are kept in memory so that new tabs don't read
+  // the same file from disk each time.
+  void GetImage(const base::FilePath& image_file, GetImageCallback callback);
+  // Reads |image_file| into memory ahead of it being requested.
+  void PrefetchImage(const base::FilePath& image_file);
+
  private:
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesServiceTest, InternalDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesServiceTest, ImageCacheTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
                            NotActiveInitially);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
@@ -62,10 +78,16 @@ class NTPBackgroundImagesService {
   void OnComponentReady(const base::FilePath& installed_dir);
   void OnGetPhotoJsonData(const std::string& photo_json);
   void NotifyObservers();
+  void OnGetImage(const base::FilePath& image_file,
+                  scoped_refptr<base::RefCountedMemory> image);
 
   base::FilePath installed_dir_;
   base::ObserverList<Observer>::Unchecked observer_list_;
   std::unique_ptr<NTPBackgroundImagesData> images_data_;
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      image_cache_;
+  // Callbacks waiting on an image which is being read from disk.
+  std::map<base::FilePath, std::vector<GetImageCallback>> pending_image_reads_;
   base::WeakPtrFactory<NTPBackgroundImagesService> weak_factory_;
 };
 
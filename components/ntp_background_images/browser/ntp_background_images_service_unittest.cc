@@ -4,7 +4,12 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <string>
+#include <utility>
 
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -33,6 +38,7 @@ TEST(NTPBackgroundImagesServiceTest, BasicTest) {
 }
 
 TEST(NTPBackgroundImagesServiceTest, InternalDataTest) {
+  base::test::TaskEnvironment task_environment;
   TestObserver observer;
   NTPBackgroundImagesService service(nullptr);
   service.AddObserver(&observer);
@@ -131,4 +137,74 @@ TEST(NTPBackgroundImagesServiceTest, InternalDataTest) {
   service.RemoveObserver(&observer);
 }
 
+TEST(NTPBackgroundImagesServiceTest, ImageCacheTest) {
+  base::test::TaskEnvironment task_environment;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath installed_dir = temp_dir.GetPath();
+
+  const std::string photo_json = R"(
+      {
+          "schemaVersion": 1,
+          "logo": {
+            "imageUrl":  "logo.png",
+            "alt": "Technikke: For music lovers",
+            "destinationUrl": "https://www.brave.com/",
+            "companyName": "Technikke"
+          },
+          "wallpapers": [
+              { "imageUrl": "background-1.jpg" },
+              { "imageUrl": "background-2.jpg" }
+          ]
+      })";
+  const std::string logo = "logo";
+  const std::string background_1 = "background 1";
+  const std::string background_2 = "background 2";
+  for (const auto& file : {std::make_pair("photo.json", photo_json),
+                           std::make_pair("logo.png", logo),
+                           std::make_pair("background-1.jpg", background_1),
+                           std::make_pair("background-2.jpg", background_2)}) {
+    ASSERT_EQ(static_cast<int>(file.second.size()),
+              base::WriteFile(installed_dir.AppendASCII(file.first),
+                              file.second.data(), file.second.size()));
+  }
+
+  NTPBackgroundImagesService service(nullptr);
+  service.OnComponentReady(installed_dir);
+  task_environment.RunUntilIdle();
+  auto* data = service.GetBackgroundImagesData();
+  ASSERT_TRUE(data);
+
+  // The logo and the first wallpaper are read when the component is ready,
+  // so they are served from memory once the files are gone.
+  ASSERT_TRUE(base::DeleteFile(data->logo_image_file, false));
+  ASSERT_TRUE(base::DeleteFile(data->backgrounds[0].image_file, false));
+
+  auto get_image = [&](const base::FilePath& image_file) {
+    std::string contents = "not run";
+    service.GetImage(image_file, base::BindOnce(
+        [](std::string* contents,
+           scoped_refptr<base::RefCountedMemory> image) {
+          *contents = image ? std::string(image->front_as<char>(),
+                                          image->size())
+                            : std::string();
+        }, &contents));
+    task_environment.RunUntilIdle();
+    return contents;
+  };
+
+  EXPECT_EQ(logo, get_image(data->logo_image_file));
+  EXPECT_EQ(background_1, get_image(data->backgrounds[0].image_file));
+
+  // Prefetched images are kept after their file is gone too.
+  service.PrefetchImage(data->backgrounds[1].image_file);
+  task_environment.RunUntilIdle();
+  ASSERT_TRUE(base::DeleteFile(data->backgrounds[1].image_file, false));
+  EXPECT_EQ(background_2, get_image(data->backgrounds[1].image_file));
+
+  // Files which can't be read give no data.
+  EXPECT_EQ(std::string(),
+            get_image(installed_dir.AppendASCII("missing.jpg")));
+}
+
 }  // namespace ntp_background_images
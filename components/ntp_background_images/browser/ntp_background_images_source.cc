@@ -8,7 +8,6 @@
 #include <utility>
 
 #include "base/bind.h"
-#include "base/files/file_util.h"
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/stringprintf.h"
@@ -20,17 +19,6 @@
 
 namespace ntp_background_images {
 
-namespace {
-
-base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
-  std::string contents;
-  if (!base::ReadFileToString(path, &contents))
-    return base::Optional<std::string>();
-  return contents;
-}
-
-}  // namespace
-
 NTPBackgroundImagesSource::NTPBackgroundImagesSource(
     NTPBackgroundImagesService* service)
     : service_(service),
@@ -73,9 +61,8 @@ void NTPBackgroundImagesSource::StartDataRequest(
         images_data->backgrounds[GetWallpaperIndexFromPath(path)].image_file;
   }
 
-  base::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+  service_->GetImage(
+      image_file_path,
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
                      weak_factory_.GetWeakPtr(),
                      std::move(callback)));
@@ -83,14 +70,8 @@ void NTPBackgroundImagesSource::StartDataRequest(
 
 void NTPBackgroundImagesSource::OnGotImageFile(
     GotDataCallback callback,
-    base::Optional<std::string> input) {
-  if (!input)
-    return;
-
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+    scoped_refptr<base::RefCountedMemory> image) {
+  std::move(callback).Run(std::move(image));
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
@@ -8,8 +8,8 @@
 
 #include <string>
 
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
-#include "base/optional.h"
 #include "content/public/browser/url_data_source.h"
 
 namespace ntp_background_images {
@@ -37,7 +37,7 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   bool AllowCaching() override;
 
   void OnGotImageFile(GotDataCallback callback,
-                      base::Optional<std::string> input);
+                      scoped_refptr<base::RefCountedMemory> image);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsWallpaperPath(const std::string& path) const;
@@ -107,6 +107,10 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    // Read the wallpaper for the next branded view while the regular
+    // backgrounds are being shown.
+    service_->PrefetchImage(GetCurrentBrandedWallpaperData()->backgrounds[
+        model_.current_wallpaper_image_index()].image_file);
   }
 }
 
@@ -0,0 +1,68 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/topsites_index.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+const size_t TopSitesIndex::kMaxGramLength = 3;
+
+TopSitesIndex::TopSitesIndex(const std::vector<std::string>& sites)
+    : sites_(sites) {
+  for (size_t site_index = 0; site_index < sites_.size(); ++site_index) {
+    const std::string& site = sites_[site_index];
+    for (size_t start = 0; start < site.length(); ++start) {
+      for (size_t length = 1;
+           length <= kMaxGramLength && start + length <= site.length();
+           ++length) {
+        std::vector<uint32_t>& posting =
+            postings_[site.substr(start, length)];
+        // Sites are added in order, so a site which contains a substring more
+        // than once is only listed once.
+        if (posting.empty() || posting.back() != site_index)
+          posting.push_back(site_index);
+      }
+    }
+  }
+}
+
+TopSitesIndex::~TopSitesIndex() {}
+
+std::vector<TopSitesIndex::Match> TopSitesIndex::Find(
+    const std::string& text,
+    size_t max_matches) const {
+  std::vector<Match> matches;
+  if (text.empty()) {
+    // Every site contains the empty string.
+    for (size_t i = 0; i < sites_.size() && matches.size() < max_matches; ++i)
+      matches.push_back({i, 0});
+    return matches;
+  }
+
+  // Every site containing |text| contains each of its substrings, so only the
+  // sites containing its rarest substring need checking.
+  const std::vector<uint32_t>* candidates = nullptr;
+  const size_t gram_length = std::min(text.length(), kMaxGramLength);
+  for (size_t start = 0; start + gram_length <= text.length(); ++start) {
+    auto it = postings_.find(text.substr(start, gram_length));
+    if (it == postings_.end())
+      return matches;
+    if (!candidates || it->second.size() < candidates->size())
+      candidates = &it->second;
+  }
+  DCHECK(candidates);
+
+  for (const uint32_t site_index : *candidates) {
+    if (matches.size() >= max_matches)
+      break;
+    const size_t position = sites_[site_index].find(text);
+    if (position != std::string::npos)
+      matches.push_back({site_index, position});
+  }
+
+  return matches;
+}
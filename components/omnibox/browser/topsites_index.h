@@ -0,0 +1,48 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_OMNIBOX_BROWSER_TOPSITES_INDEX_H_
+#define BRAVE_COMPONENTS_OMNIBOX_BROWSER_TOPSITES_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+
+// Indexes a list of sites by every substring of up to three characters, so
+// that finding the sites which contain some text only looks at the sites
+// which contain its rarest part instead of every site in turn.
+class TopSitesIndex {
+ public:
+  struct Match {
+    // Position of the site in the indexed list.
+    size_t site_index;
+    // Position of the text in the site.
+    size_t position;
+  };
+
+  // |sites| must outlive the index.
+  explicit TopSitesIndex(const std::vector<std::string>& sites);
+  ~TopSitesIndex();
+
+  // Returns the first |max_matches| sites containing |text|, in the order
+  // they are listed in.
+  std::vector<Match> Find(const std::string& text, size_t max_matches) const;
+
+ private:
+  static const size_t kMaxGramLength;
+
+  const std::vector<std::string>& sites_;
+  // The positions of the sites containing each substring, in ascending order.
+  std::unordered_map<std::string, std::vector<uint32_t>> postings_;
+
+  DISALLOW_COPY_AND_ASSIGN(TopSitesIndex);
+};
+
+#endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_TOPSITES_INDEX_H_
@@ -0,0 +1,107 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/topsites_index.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Matches the way TopSitesProvider searched the list before it was indexed.
+std::vector<TopSitesIndex::Match> FindLinear(
+    const std::vector<std::string>& sites,
+    const std::string& text,
+    size_t max_matches) {
+  std::vector<TopSitesIndex::Match> matches;
+  for (size_t i = 0; i < sites.size() && matches.size() < max_matches; ++i) {
+    const size_t position = sites[i].find(text);
+    if (position != std::string::npos)
+      matches.push_back({i, position});
+  }
+  return matches;
+}
+
+void ExpectMatchesLinear(const std::vector<std::string>& sites,
+                         const TopSitesIndex& index,
+                         const std::string& text,
+                         size_t max_matches) {
+  const std::vector<TopSitesIndex::Match> expected =
+      FindLinear(sites, text, max_matches);
+  const std::vector<TopSitesIndex::Match> actual =
+      index.Find(text, max_matches);
+  ASSERT_EQ(expected.size(), actual.size()) << text;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].site_index, actual[i].site_index) << text;
+    EXPECT_EQ(expected[i].position, actual[i].position) << text;
+  }
+}
+
+// Generates |count| distinct domain names with a mix of common and rare parts.
+std::vector<std::string> GenerateSites(size_t count) {
+  const std::vector<std::string> kWords = {
+      "brave", "mail", "news", "shop", "video", "maps", "cloud", "bank",
+      "photo", "music", "game", "blog", "wiki", "store", "travel", "sport"};
+  const std::vector<std::string> kTlds = {".com", ".org", ".net", ".co.uk",
+                                          ".de", ".io"};
+  std::vector<std::string> sites;
+  for (size_t i = 0; i < count; ++i) {
+    std::string site = kWords[i % kWords.size()];
+    site += kWords[(i / kWords.size()) % kWords.size()];
+    site += std::to_string(i / (kWords.size() * kWords.size()));
+    site += kTlds[i % kTlds.size()];
+    sites.push_back(site);
+  }
+  return sites;
+}
+
+}  // namespace
+
+TEST(TopSitesIndexTest, EmptyIndex) {
+  const std::vector<std::string> sites;
+  TopSitesIndex index(sites);
+  EXPECT_TRUE(index.Find("brave", 10).empty());
+  EXPECT_TRUE(index.Find("", 10).empty());
+}
+
+TEST(TopSitesIndexTest, FindsSitesInListOrder) {
+  const std::vector<std::string> sites = {
+      "google.com", "mail.google.com", "brave.com", "gmail.com", "bbc.co.uk"};
+  TopSitesIndex index(sites);
+
+  std::vector<TopSitesIndex::Match> matches = index.Find("mail", 10);
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(1u, matches[0].site_index);
+  EXPECT_EQ(0u, matches[0].position);
+  EXPECT_EQ(3u, matches[1].site_index);
+  EXPECT_EQ(1u, matches[1].position);
+
+  matches = index.Find(".com", 2);
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(0u, matches[0].site_index);
+  EXPECT_EQ(1u, matches[1].site_index);
+
+  // Contains each trigram of the text but not the text itself.
+  EXPECT_TRUE(index.Find("google.co.uk", 10).empty());
+  EXPECT_TRUE(index.Find("duckduckgo", 10).empty());
+}
+
+// Checks the index against searching every site in turn, over a list much
+// larger than the bundled one.
+TEST(TopSitesIndexTest, MatchesLinearScanOnLargeList) {
+  const std::vector<std::string> sites = GenerateSites(50000);
+  TopSitesIndex index(sites);
+
+  const std::vector<std::string> kInputs = {
+      "", "b", "br", "bra", "brave", "bravemail", "mailbrave", "sport1",
+      "sport19", "travelsport", "travelsport195.de", ".co", ".co.uk", "o.u",
+      "e1", "9.", "photophoto", "zzz", "bravebrave0.com", "\xD1\x82"};
+  for (const auto& input : kInputs) {
+    ExpectMatchesLinear(sites, index, input, 8);
+    ExpectMatchesLinear(sites, index, input, sites.size());
+  }
+}
@@ -10,8 +10,10 @@
 #include <algorithm>
 #include <string>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "brave/components/omnibox/browser/topsites_index.h"
 #include "components/omnibox/browser/autocomplete_input.h"
 #include "components/omnibox/browser/history_provider.h"
 
@@ -35,16 +37,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
-       ++i) {
-    const std::string &current_site = *i;
-    size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+  for (const TopSitesIndex::Match& found :
+       GetIndex().Find(input_text, provider_max_matches())) {
+    const std::string& current_site = top_sites_[found.site_index];
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, found.position);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i) {
@@ -63,6 +61,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
 
 TopSitesProvider::~TopSitesProvider() {}
 
+// static
+const TopSitesIndex& TopSitesProvider::GetIndex() {
+  static const base::NoDestructor<TopSitesIndex> index(top_sites_);
+  return *index;
+}
+
 // static
 ACMatchClassifications TopSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
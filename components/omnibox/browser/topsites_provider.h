@@ -14,6 +14,7 @@
 #include "components/omnibox/browser/autocomplete_provider.h"
 
 class AutocompleteProviderClient;
+class TopSitesIndex;
 
 // This is the provider for top Alexa 500 sites URLs
 class TopSitesProvider : public AutocompleteProvider {
@@ -30,6 +31,9 @@ class TopSitesProvider : public AutocompleteProvider {
 
   static std::vector<std::string> top_sites_;
 
+  // Built from |top_sites_| the first time it is needed.
+  static const TopSitesIndex& GetIndex();
+
   void AddMatch(const base::string16& match_string,
                 const ACMatchClassifications& styles);
 
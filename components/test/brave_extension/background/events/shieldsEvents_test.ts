@@ -24,4 +24,26 @@ describe('shieldsEvents events', () => {
       chrome.braveShields.onBlocked.emit(blockedResource)
     })
   })
+  describe('chrome.braveShields.onBlockedBatch listener', () => {
+    let spy: jest.SpyInstance
+    beforeEach(() => {
+      spy = jest.spyOn(actions, 'resourceBlocked')
+    })
+    afterEach(() => {
+      spy.mockRestore()
+    })
+    it('forwards each of the details to actions.resourceBlocked', (cb) => {
+      const otherBlockedResource = {
+        ...blockedResource,
+        subresource: 'https://www.brave.com/other.js'
+      }
+      chrome.braveShields.onBlockedBatch.addListener((details) => {
+        expect(spy).toHaveBeenCalledTimes(2)
+        expect(spy).toHaveBeenNthCalledWith(1, blockedResource)
+        expect(spy).toHaveBeenNthCalledWith(2, otherBlockedResource)
+        cb()
+      })
+      chrome.braveShields.onBlockedBatch.emit([blockedResource, otherBlockedResource])
+    })
+  })
 })
@@ -0,0 +1,40 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Helpers
+import { taskize } from '../../../brave_extension/extension/brave_extension/helpers/taskUtils'
+
+describe('taskUtils test', () => {
+  describe('taskize', () => {
+    beforeEach(() => {
+      jest.useFakeTimers()
+    })
+
+    afterEach(() => {
+      jest.useRealTimers()
+    })
+
+    it('runs several calls made before the next task once', () => {
+      const onTask = jest.fn()
+      const willRunOnTask = taskize(onTask)
+      for (let i = 0; i < 5; i++) {
+        willRunOnTask()
+      }
+      expect(onTask).not.toHaveBeenCalled()
+      jest.runAllTimers()
+      expect(onTask).toHaveBeenCalledTimes(1)
+    })
+
+    it('can be scheduled again once it has run', () => {
+      const onTask = jest.fn()
+      const willRunOnTask = taskize(onTask)
+      willRunOnTask()
+      jest.runAllTimers()
+      willRunOnTask()
+      willRunOnTask()
+      jest.runAllTimers()
+      expect(onTask).toHaveBeenCalledTimes(2)
+    })
+  })
+})
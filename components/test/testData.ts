@@ -214,6 +214,7 @@ export const getMockChrome = () => {
     },
     braveShields: {
       onBlocked: new ChromeEvent(),
+      onBlockedBatch: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -296,6 +297,7 @@ export const getMockChrome = () => {
         return Promise.resolve()
       },
       onBlocked: new ChromeEvent(),
+      onBlockedBatch: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
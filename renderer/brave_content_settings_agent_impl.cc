@@ -10,6 +10,8 @@
 #include <vector>
 
 #include "base/bind_helpers.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
@@ -29,6 +31,18 @@
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "url/url_constants.h"
 
+namespace {
+
+// Secondary pattern of fingerprinting rules which apply to the first party
+// only, i.e. the top frame's host and its subdomains.
+const ContentSettingsPattern& GetFirstPartyPattern() {
+  static const base::NoDestructor<ContentSettingsPattern> first_party_pattern(
+      ContentSettingsPattern::FromString("https://firstParty/*"));
+  return *first_party_pattern;
+}
+
+}  // namespace
+
 BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
     content::RenderFrame* render_frame,
     bool should_whitelist,
@@ -61,6 +75,7 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    ClearCachedSettings();
   }
 
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(
@@ -153,31 +168,55 @@ GURL BraveContentSettingsAgentImpl::GetOriginOrURL(
   return top_origin.GetURL();
 }
 
+void BraveContentSettingsAgentImpl::ClearCachedSettings() {
+  cached_shields_down_.clear();
+  cached_fingerprinting_settings_.clear();
+  cached_content_setting_rules_ = content_setting_rules_;
+  cached_content_setting_rules_generation_ =
+      content_setting_rules_ ? content_setting_rules_->generation : 0;
+}
+
+void BraveContentSettingsAgentImpl::ClearCachedSettingsIfRulesChanged() {
+  // The rules are overwritten in place when the browser sends new ones, so
+  // compare their generation as well as their address
+  if (cached_content_setting_rules_ != content_setting_rules_ ||
+      (content_setting_rules_ && content_setting_rules_->generation !=
+          cached_content_setting_rules_generation_)) {
+    ClearCachedSettings();
+  }
+}
+
 ContentSetting BraveContentSettingsAgentImpl::GetFPContentSettingFromRules(
     const ContentSettingsForOneType& rules,
-    const blink::WebFrame* frame,
+    const GURL& primary_url,
     const GURL& secondary_url) {
-
-  if (rules.size() == 0)
-    return CONTENT_SETTING_DEFAULT;
-
-  const GURL& primary_url = GetOriginOrURL(frame);
-
+  base::Optional<ContentSettingsPattern> first_party_pattern;
   for (const auto& rule : rules) {
-    ContentSettingsPattern secondary_pattern = rule.secondary_pattern;
-    if (rule.secondary_pattern ==
-        ContentSettingsPattern::FromString("https://firstParty/*")) {
-      secondary_pattern = ContentSettingsPattern::FromString(
-          "[*.]" + GetOriginOrURL(frame).HostNoBrackets());
+    const ContentSettingsPattern* secondary_pattern = &rule.secondary_pattern;
+    if (rule.secondary_pattern == GetFirstPartyPattern()) {
+      if (!first_party_pattern) {
+        first_party_pattern = ContentSettingsPattern::FromString(
+            "[*.]" + primary_url.HostNoBrackets());
+      }
+      secondary_pattern = &first_party_pattern.value();
     }
 
     if (rule.primary_pattern.Matches(primary_url) &&
-        (secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         secondary_pattern.Matches(secondary_url))) {
+        (*secondary_pattern == ContentSettingsPattern::Wildcard() ||
+         secondary_pattern->Matches(secondary_url))) {
       return rule.GetContentSetting();
     }
   }
 
+  // Fingerprinting is allowed by default for first party resources
+  if (!first_party_pattern) {
+    first_party_pattern = ContentSettingsPattern::FromString(
+        "[*.]" + primary_url.HostNoBrackets());
+  }
+  if (first_party_pattern->Matches(secondary_url)) {
+    return CONTENT_SETTING_ALLOW;
+  }
+
   // for cases which are third party resources and doesn't match any existing
   // rules, block them by default
   return CONTENT_SETTING_BLOCK;
@@ -186,20 +225,31 @@ ContentSetting BraveContentSettingsAgentImpl::GetFPContentSettingFromRules(
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
+  if (!content_setting_rules_) {
+    return false;
+  }
+
+  ClearCachedSettingsIfRulesChanged();
+
   const GURL& primary_url = GetOriginOrURL(frame);
+  const auto key = std::make_pair(primary_url, secondary_url);
+  const auto it = cached_shields_down_.find(key);
+  if (it != cached_shields_down_.end()) {
+    return it->second;
+  }
 
-  if (content_setting_rules_) {
-    for (const auto& rule : content_setting_rules_->brave_shields_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
+  ContentSetting setting = CONTENT_SETTING_DEFAULT;
+  for (const auto& rule : content_setting_rules_->brave_shields_rules) {
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      setting = rule.GetContentSetting();
+      break;
     }
   }
 
-  return setting == CONTENT_SETTING_BLOCK;
+  const bool shields_down = setting == CONTENT_SETTING_BLOCK;
+  cached_shields_down_.emplace(key, shields_down);
+  return shields_down;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -216,20 +266,22 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
   if (brave::IsWhitelistedFingerprintingException(primary_url, secondary_url)) {
     return true;
   }
-  ContentSettingsForOneType rules;
-  if (content_setting_rules_) {
-      rules = content_setting_rules_->fingerprinting_rules;
+
+  ContentSetting setting = CONTENT_SETTING_DEFAULT;
+  const auto key = std::make_pair(primary_url, secondary_url);
+  const auto it = cached_fingerprinting_settings_.find(key);
+  if (it != cached_fingerprinting_settings_.end()) {
+    setting = it->second;
+  } else if (content_setting_rules_) {
+    setting = GetFPContentSettingFromRules(
+        content_setting_rules_->fingerprinting_rules, primary_url,
+        secondary_url);
+    cached_fingerprinting_settings_.emplace(key, setting);
+  } else {
+    setting = GetFPContentSettingFromRules(ContentSettingsForOneType(),
+        primary_url, secondary_url);
   }
-  ContentSettingPatternSource default_rule = ContentSettingPatternSource(
-      ContentSettingsPattern::Wildcard(),
-      ContentSettingsPattern::FromString("https://firstParty/*"),
-      base::Value::FromUniquePtrValue(
-          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-      std::string(), false);
-  rules.push_back(default_rule);
-  ContentSetting setting =
-      GetFPContentSettingFromRules(rules, frame, secondary_url);
-  rules.pop_back();
+
   bool allow = setting != CONTENT_SETTING_BLOCK;
   allow = allow || IsWhitelistedForContentSettings();
 
@@ -6,7 +6,9 @@
 #ifndef BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 #define BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/strings/string16.h"
@@ -46,9 +48,11 @@ class BraveContentSettingsAgentImpl
  private:
   GURL GetOriginOrURL(const blink::WebFrame* frame);
 
+  // Fingerprinting setting for |secondary_url| in a page on |primary_url|,
+  // falling back to allowing first party resources if no rule matches.
   ContentSetting GetFPContentSettingFromRules(
       const ContentSettingsForOneType& rules,
-      const blink::WebFrame* frame,
+      const GURL& primary_url,
       const GURL& secondary_url);
 
   bool IsBraveShieldsDown(
@@ -63,6 +67,9 @@ class BraveContentSettingsAgentImpl
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
+  void ClearCachedSettings();
+  void ClearCachedSettingsIfRulesChanged();
+
   // Origins of scripts which are temporary allowed for this frame in the
   // current load
   base::flat_set<std::string> temporarily_allowed_scripts_;
@@ -73,6 +80,15 @@ class BraveContentSettingsAgentImpl
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // Shields and fingerprinting decisions for (primary, secondary) URLs in the
+  // current load, since pages can hit fingerprinting APIs thousands of times.
+  // Cleared on navigation and whenever the content setting rules change.
+  std::map<std::pair<GURL, GURL>, bool> cached_shields_down_;
+  std::map<std::pair<GURL, GURL>, ContentSetting>
+      cached_fingerprinting_settings_;
+  const RendererContentSettingRules* cached_content_setting_rules_ = nullptr;
+  int cached_content_setting_rules_generation_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
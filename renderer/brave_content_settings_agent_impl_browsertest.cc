@@ -4,9 +4,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/test/test_timeouts.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "brave/common/brave_paths.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/ui/browser.h"
@@ -46,6 +51,12 @@ const char kGetImageDataScript[] =
 
 const int kExpectedImageDataHash = 261040;
 
+// measureText returns empty metrics when fingerprinting is blocked
+const char kMeasureTextScript[] =
+    "var canvas = document.createElement('canvas');"
+    "domAutomationController.send("
+    "    canvas.getContext('2d').measureText('fingerprint').width > 0);";
+
 const char kEmptyCookie[] = "";
 
 #define COOKIE_STR "test=hi"
@@ -273,6 +284,28 @@ class BraveContentSettingsAgentImplBrowserTest : public InProcessBrowserTest {
     ASSERT_EQ(child_frame()->GetLastCommittedURL(), iframe_url());
   }
 
+  // Content setting rules are sent to the renderer asynchronously, so keep
+  // checking until the page sees the new setting. The page is not reloaded.
+  void WaitForMeasureTextAllowed(bool allowed) {
+    bool value = !allowed;
+    while (true) {
+      EXPECT_TRUE(
+          ExecuteScriptAndExtractBool(contents(), kMeasureTextScript, &value));
+      if (value == allowed)
+        return;
+
+      base::RunLoop run_loop;
+      base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE, run_loop.QuitClosure(), TestTimeouts::tiny_timeout());
+      run_loop.Run();
+    }
+  }
+
+  brave_shields::BraveShieldsWebContentsObserver* shields_observer() {
+    return brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+        contents());
+  }
+
   template <typename T>
   void CheckCookie(T* frame, base::StringPiece cookie) {
     EXPECT_EQ(ExecScriptGetStr(kCookieScript, frame), cookie);
@@ -313,6 +346,27 @@ IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
   EXPECT_EQ(kExpectedImageDataHash, hash);
 }
 
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
+                       FingerprintingRulesChangeWithoutNavigation) {
+  NavigateToPageWithIframe();
+  const GURL committed_url = contents()->GetLastCommittedURL();
+  WaitForMeasureTextAllowed(true);
+
+  BlockFingerprinting();
+  WaitForMeasureTextAllowed(false);
+
+  ShieldsDown();
+  WaitForMeasureTextAllowed(true);
+
+  ShieldsUp();
+  WaitForMeasureTextAllowed(false);
+
+  AllowFingerprinting();
+  WaitForMeasureTextAllowed(true);
+
+  EXPECT_EQ(contents()->GetLastCommittedURL(), committed_url);
+}
+
 IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
                        BlockReferrerByDefault) {
   ContentSettingsForOneType settings;
@@ -548,3 +602,58 @@ IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
   NavigateToURLUntilLoadStop("b.com", "/load_js_from_origins.html");
   EXPECT_EQ(contents()->GetAllFrames().size(), 1u);
 }
+
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
+                       BlockedScriptsGetDispatchedInOneBatch) {
+  BlockScripts();
+
+  ASSERT_TRUE(shields_observer());
+  // Keep the events queued until the test flushes them
+  shields_observer()->SetBlockedEventsFlushDelayForTesting(
+      base::TimeDelta::FromHours(1));
+  shields_observer()->FlushBlockedEventsForTesting();
+  const size_t dispatched_blocked_event_count =
+      shields_observer()->GetDispatchedBlockedEventCountForTesting();
+  const size_t dispatched_blocked_event_batch_count =
+      shields_observer()->GetDispatchedBlockedEventBatchCountForTesting();
+
+  NavigateToURLUntilLoadStop("a.com", "/load_js_from_origins.html");
+  EXPECT_EQ(contents()->GetAllFrames().size(), 1u);
+
+  shields_observer()->FlushBlockedEventsForTesting();
+  EXPECT_GT(shields_observer()->GetDispatchedBlockedEventCountForTesting(),
+            dispatched_blocked_event_count + 1);
+  EXPECT_EQ(shields_observer()->GetDispatchedBlockedEventBatchCountForTesting(),
+            dispatched_blocked_event_batch_count + 1);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplBrowserTest,
+                       BlockedFingerprintingGetsDispatchedInOneBatch) {
+  BlockFingerprinting();
+
+  NavigateToPageWithIframe();
+  WaitForMeasureTextAllowed(false);
+
+  ASSERT_TRUE(shields_observer());
+  // Keep the events queued until the test flushes them
+  shields_observer()->SetBlockedEventsFlushDelayForTesting(
+      base::TimeDelta::FromHours(1));
+  shields_observer()->FlushBlockedEventsForTesting();
+  const size_t dispatched_blocked_event_count =
+      shields_observer()->GetDispatchedBlockedEventCountForTesting();
+  const size_t dispatched_blocked_event_batch_count =
+      shields_observer()->GetDispatchedBlockedEventBatchCountForTesting();
+
+  bool allowed = true;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(
+        ExecuteScriptAndExtractBool(contents(), kMeasureTextScript, &allowed));
+    EXPECT_FALSE(allowed);
+  }
+
+  shields_observer()->FlushBlockedEventsForTesting();
+  EXPECT_GE(shields_observer()->GetDispatchedBlockedEventCountForTesting(),
+            dispatched_blocked_event_count + 3);
+  EXPECT_EQ(shields_observer()->GetDispatchedBlockedEventBatchCountForTesting(),
+            dispatched_blocked_event_batch_count + 1);
+}